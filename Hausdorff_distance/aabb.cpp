@@ -1,49 +1,123 @@
 #include "aabb.h"
+#include "rational.h"
 #include "utils.h"
 #include <algorithm>
 
-#define RES 100
+static inline void arc_aabb_kernel(const Arc &arc, AABB &res){
+    // Line is stored as a start point in center, and an end point in begin and end, it needs no cos and sin
+    if (arc.radius != arc.radius){
+        res.x[0] = std::min(arc.center[0], arc.begin);
+        res.x[1] = std::max(arc.center[0], arc.begin);
+        res.y[0] = std::min(arc.center[1], arc.end);
+        res.y[1] = std::max(arc.center[1], arc.end);
+        return;
+    }
 
-AABB get_arc_aabb(const Arc *arc){
-    REAL begin, end;
-    begin = arc->begin < 0 ? arc->begin + 2 * M_PI : arc->begin;
-    end = arc->begin < 0 ? arc->end + 2 * M_PI : arc->end;
-    
-    std::vector<REAL> cand_x;
-    std::vector<REAL> cand_y;
+    const REAL two_pi = 2.0 * M_PI;
+    const REAL half_pi = 0.5 * M_PI;
 
-    if (arc->radius != arc->radius){
-        cand_x.push_back(arc->center[0]);
-        cand_x.push_back(arc->begin);
-        cand_y.push_back(arc->center[1]);
-        cand_y.push_back(arc->end);
-    }
-    else {
-        if (begin < 0.5 * M_PI && end > 0.5 * M_PI)
-            cand_y.push_back(arc->center[1] + arc->radius);
-        if (begin < 1.0 * M_PI && end > 1.0 * M_PI)
-            cand_x.push_back(arc->center[0] - arc->radius);
-        if (begin < 1.5 * M_PI && end > 1.5 * M_PI)
-            cand_y.push_back(arc->center[1] - arc->radius);
-        if (begin < 2.0 * M_PI && end > 2.0 * M_PI)
-            cand_x.push_back(arc->center[0] + arc->radius);
+    const REAL x_begin = arc.center[0] + arc.radius * cos(arc.begin);
+    const REAL y_begin = arc.center[1] + arc.radius * sin(arc.begin);
+    const REAL x_end = arc.center[0] + arc.radius * cos(arc.end);
+    const REAL y_end = arc.center[1] + arc.radius * sin(arc.end);
+
+    // Angle from begin to direction 0 wrapped into [0, 2pi), arc contains direction k * pi/2 if offset is within sweep
+    const REAL sweep = arc.end - arc.begin;
+    REAL offset = -arc.begin - two_pi * std::floor(-arc.begin / two_pi);
+    const REAL off0 = offset;
+    offset += half_pi;
+    const REAL off1 = offset >= two_pi ? offset - two_pi : offset;
+    offset += half_pi;
+    const REAL off2 = offset >= two_pi ? offset - two_pi : offset;
+    offset += half_pi;
+    const REAL off3 = offset >= two_pi ? offset - two_pi : offset;
 
-        cand_x.push_back(arc->center[0] + arc->radius * cos(arc->begin));
-        cand_x.push_back(arc->center[0] + arc->radius * cos(arc->end));
-        cand_y.push_back(arc->center[1] + arc->radius * sin(arc->begin));
-        cand_y.push_back(arc->center[1] + arc->radius * sin(arc->end));
+    REAL ax0 = std::min(x_begin, x_end), ax1 = std::max(x_begin, x_end);
+    REAL ay0 = std::min(y_begin, y_end), ay1 = std::max(y_begin, y_end);
+    ax1 = off0 < sweep ? arc.center[0] + arc.radius : ax1;
+    ay1 = off1 < sweep ? arc.center[1] + arc.radius : ay1;
+    ax0 = off2 < sweep ? arc.center[0] - arc.radius : ax0;
+    ay0 = off3 < sweep ? arc.center[1] - arc.radius : ay0;
+
+    res.x[0] = ax0;
+    res.x[1] = ax1;
+    res.y[0] = ay0;
+    res.y[1] = ay1;
+}
+
+AABB get_arc_aabb(const Arc *arc){
+    AABB res;
+    arc_aabb_kernel(*arc, res);
+    return res;
+}
+
+void get_arc_aabb(const Arc *arcs, AABB *boxes, int num_arcs){
+    for (int i = 0; i < num_arcs; i++){
+        arc_aabb_kernel(arcs[i], boxes[i]);
     }
+}
 
+AABB get_arc_aabb(const VectorArc *arc){
     AABB res;
-    auto minmax_x = std::minmax_element(cand_x.begin(), cand_x.end());
-    auto minmax_y = std::minmax_element(cand_y.begin(), cand_y.end());
+    SET_VECTOR2(res.x, std::min(arc->begin[0], arc->end[0]), std::max(arc->begin[0], arc->end[0]));
+    SET_VECTOR2(res.y, std::min(arc->begin[1], arc->end[1]), std::max(arc->begin[1], arc->end[1]));
+    if (arc->is_line()) return res;
 
-    SET_VECTOR2(res.x, *(minmax_x.first), *(minmax_x.second));
-    SET_VECTOR2(res.y, *(minmax_y.first), *(minmax_y.second));
+    // Extend to the circle where arc passes through each axis direction
+    const Point dirs[4] = { { 1.0, 0.0 }, { 0.0, 1.0 }, { -1.0, 0.0 }, { 0.0, -1.0 } };
+    if (arc->contains(dirs[0])) res.x[1] = arc->center[0] + arc->radius;
+    if (arc->contains(dirs[1])) res.y[1] = arc->center[1] + arc->radius;
+    if (arc->contains(dirs[2])) res.x[0] = arc->center[0] - arc->radius;
+    if (arc->contains(dirs[3])) res.y[0] = arc->center[1] - arc->radius;
 
     return res;
 }
 
+void get_arc_aabb(const VectorArc *arcs, AABB *boxes, int num_arcs){
+    // Endpoint box is shared by both kinds, arcs then extend it in place where they pass an axis direction
+    for (int i = 0; i < num_arcs; i++){
+        SET_VECTOR2(boxes[i].x, std::min(arcs[i].begin[0], arcs[i].end[0]), std::max(arcs[i].begin[0], arcs[i].end[0]));
+        SET_VECTOR2(boxes[i].y, std::min(arcs[i].begin[1], arcs[i].end[1]), std::max(arcs[i].begin[1], arcs[i].end[1]));
+    }
+    const Point dirs[4] = { { 1.0, 0.0 }, { 0.0, 1.0 }, { -1.0, 0.0 }, { 0.0, -1.0 } };
+    for (int i = 0; i < num_arcs; i++){
+        const VectorArc &arc = arcs[i];
+        if (arc.kind == KIND_LINE) continue;
+        if (arc.contains(dirs[0])) boxes[i].x[1] = arc.center[0] + arc.radius;
+        if (arc.contains(dirs[1])) boxes[i].y[1] = arc.center[1] + arc.radius;
+        if (arc.contains(dirs[2])) boxes[i].x[0] = arc.center[0] - arc.radius;
+        if (arc.contains(dirs[3])) boxes[i].y[0] = arc.center[1] - arc.radius;
+    }
+}
+
+AABB get_curve_aabb(const QuadraticBezierCurve *curve){
+	AABB box;
+	REAL *bounds[2] = { box.x, box.y };
+	for (int k = 0; k < 2; k++){
+		const REAL p0 = curve->control_pts[0][k], p1 = curve->control_pts[1][k], p2 = curve->control_pts[2][k];
+		bounds[k][0] = std::min(p0, p2);
+		bounds[k][1] = std::max(p0, p2);
+		// Derivative is zero at t = (p0 - p1) / (p0 - 2 p1 + p2)
+		const REAL denom = p0 - 2 * p1 + p2;
+		if (denom == 0.0) continue;
+		const REAL t = (p0 - p1) / denom;
+		if (t <= 0.0 || t >= 1.0) continue;
+		const REAL extremum = (1 - t) * (1 - t) * p0 + 2 * (1 - t) * t * p1 + t * t * p2;
+		bounds[k][0] = std::min(bounds[k][0], extremum);
+		bounds[k][1] = std::max(bounds[k][1], extremum);
+	}
+	return box;
+}
+
+AABB get_curve_aabb(const LineSegment *line){
+	AABB box;
+	box.x[0] = std::min(line->control_pts[0][0], line->control_pts[1][0]);
+	box.x[1] = std::max(line->control_pts[0][0], line->control_pts[1][0]);
+	box.y[0] = std::min(line->control_pts[0][1], line->control_pts[1][1]);
+	box.y[1] = std::max(line->control_pts[0][1], line->control_pts[1][1]);
+	return box;
+}
+
 CubicBezierCurve to_bezier(const Arc *arc){
     CubicBezierCurve bezier;
     Point *p;
@@ -82,7 +156,50 @@ CubicBezierCurve to_bezier(const Arc *arc){
     return bezier;
 }
 
+CubicBezierCurve to_bezier(const VectorArc *arc){
+    CubicBezierCurve bezier;
+    Point *p;
+    p = (bezier.control_pts);
+    copy_point(arc->begin, p[0]);
+    copy_point(arc->end, p[3]);
+    if (arc->is_line()){
+        middle_point(p[0], p[3], p[1]);
+        middle_point(p[1], p[3], p[2]);
+        middle_point(p[0], p[1], p[1]);
+    }
+    else {
+        // Intersection of two tangent lines lies on the bisector, at distance r / cos(sweep / 2) from the center
+        Point u, v;
+        subtract_point(arc->begin, arc->center, u);
+        subtract_point(arc->end, arc->center, v);
+        REAL r_sq = arc->radius * arc->radius;
+        REAL denom = r_sq + u[0] * v[0] + u[1] * v[1];
+
+        if (denom == 0.0) {
+            // Tangents of a half circle are parallel, the usual cubic of a half circle has tangents of 4/3 radius
+            SET_VECTOR2(p[1], p[0][0] - u[1] * 4.0 / 3.0, p[0][1] + u[0] * 4.0 / 3.0);
+            SET_VECTOR2(p[2], p[3][0] + v[1] * 4.0 / 3.0, p[3][1] - v[0] * 4.0 / 3.0);
+        }
+        else {
+            REAL scale = r_sq / denom;
+            Point intersection;
+            SET_VECTOR2(intersection, arc->center[0] + (u[0] + v[0]) * scale, arc->center[1] + (u[1] + v[1]) * scale);
+
+            SET_VECTOR2(p[1], (p[0][0] + intersection[0] * 2.0)/3.0, (p[0][1] + intersection[1] * 2.0)/3.0);
+            SET_VECTOR2(p[2], (p[3][0] + intersection[0] * 2.0)/3.0, (p[3][1] + intersection[1] * 2.0)/3.0);
+        }
+    }
+
+    return bezier;
+}
+
 REAL arc_approx_error_bound(const Arc *arc, const CubicBezierCurve *curve){
+    // Arc is exact as a rational quadratic, only the distance to the curve remains
+    RationalBezier<2> conic;
+    if (to_rational(arc, &conic)){
+        return rational_error_bound(curve, &conic);
+    }
+
     CubicBezierCurve approx_arc = to_bezier(arc);
     REAL inter_bezier_error = bezier_error_bound(curve, &approx_arc);
 
@@ -91,6 +208,7 @@ REAL arc_approx_error_bound(const Arc *arc, const CubicBezierCurve *curve){
         return inter_bezier_error;
     }
 
+    // Arc of half circle or wider is approximated by a cubic, its error is estimated at the middle
     REAL mid_angle = (arc->begin + arc->end) / 2.0;
     Point e_q, e_o;
     evaluate(&approx_arc, 0.5, e_q);
@@ -101,6 +219,41 @@ REAL arc_approx_error_bound(const Arc *arc, const CubicBezierCurve *curve){
     return arc_bezier_error + inter_bezier_error;
 }
 
+REAL arc_approx_error_bound(const VectorArc *arc, const CubicBezierCurve *curve){
+    RationalBezier<2> conic;
+    if (to_rational(arc, &conic)){
+        return rational_error_bound(curve, &conic);
+    }
+
+    CubicBezierCurve approx_arc = to_bezier(arc);
+    REAL inter_bezier_error = bezier_error_bound(curve, &approx_arc);
+
+    // No approxmiation error for a line
+    if (arc->is_line()){
+        return inter_bezier_error;
+    }
+
+    // Arc of half circle or wider is approximated by a cubic, its error is estimated at the middle
+    // Middle point of the arc is on the bisector of two endpoints
+    Point mid;
+    SET_VECTOR2(mid, arc->begin[0] + arc->end[0] - 2.0 * arc->center[0], arc->begin[1] + arc->end[1] - 2.0 * arc->center[1]);
+    if (norm(mid) < EPS){
+        SET_VECTOR2(mid, arc->center[1] - arc->begin[1], arc->begin[0] - arc->center[0]);
+    }
+    else if (arc->major){
+        SET_VECTOR2(mid, -mid[0], -mid[1]);
+    }
+    normalize(mid);
+
+    Point e_q, e_o;
+    evaluate(&approx_arc, 0.5, e_q);
+    SET_VECTOR2(e_o, arc->center[0] + arc->radius * mid[0], arc->center[1] + arc->radius * mid[1]);
+
+    REAL arc_bezier_error = distance(e_q, e_o);
+
+    return arc_bezier_error + inter_bezier_error;
+}
+
 REAL bezier_error_bound(const CubicBezierCurve *curve1, const CubicBezierCurve *curve2){
     REAL bound1 = 0.0, bound2 = 0.0;
     for (int i = 0; i < 4; i++){
@@ -125,49 +278,6 @@ AABB combine(const AABB &box1, const AABB &box2){
     return res;
 }
 
-REAL get_AABB(const CubicBezierCurve &seg, const Arc arc, AABB& box, bool isDraw){
-	REAL error;
-
-	glColor3ub(64, 192, 0);
-    box = get_arc_aabb(&arc);
-
-    error = arc_approx_error_bound(&arc, &seg);
-
-    if (isDraw){
-        if (arc.radius != arc.radius){
-            glBegin(GL_LINE_STRIP);
-            glVertex2f(arc.center[0], arc.center[1]);
-            glVertex2f(arc.begin, arc.end);
-            glEnd();
-        }
-        else {
-            glBegin(GL_LINE_STRIP);
-            for (int i = 0; i <= RES; i++)
-            {
-                Point pt;
-                const REAL t = (REAL)i / (REAL)RES;
-                const REAL angle = t * (arc.end - arc.begin) + arc.begin;
-                pt[0] = arc.center[0] + arc.radius * cos(angle);
-                pt[1] = arc.center[1] + arc.radius * sin(angle);
-                glVertex2f(pt[0], pt[1]);
-            }
-            glEnd();
-        }
-    }
-
-	return error;
-}
-
-void draw_AABB(const AABB &box){
-	glBegin(GL_LINE_STRIP);
-	glVertex2f(box.x[0], box.y[0]);
-	glVertex2f(box.x[0], box.y[1]);
-	glVertex2f(box.x[1], box.y[1]);
-	glVertex2f(box.x[1], box.y[0]);
-	glVertex2f(box.x[0], box.y[0]);
-	glEnd();
-}
-
 REAL distance(const AABB &box1, const AABB &box2){
     REAL squared = 0.0;
     if (box1.x[1] < box2.x[0] || box1.x[0] > box2.x[1]){
@@ -184,4 +294,16 @@ REAL distance(const AABB &box1, const AABB &box2){
 
 REAL volume(const AABB &box){
     return (box.x[1] - box.x[0]) * (box.y[1] - box.y[0]);
-}
\ No newline at end of file
+}
+
+REAL diameter(const AABB &box){
+    REAL w = box.x[1] - box.x[0], h = box.y[1] - box.y[0];
+    return std::sqrt(w * w + h * h);
+}
+
+bool test_aabb_collision(const AABB &box1, const AABB &box2){
+    bool collision = !(box1.x[1] < box2.x[0] || box2.x[1] < box1.x[0]);
+    collision = !(box1.y[1] < box2.y[0] || box2.y[1] < box1.y[0]) && collision;
+
+    return collision;
+}
@@ -1,4 +1,6 @@
-#include <GL/glut.h>
+#ifndef _AABB_H_
+#define _AABB_H_
+
 #include "curve.h"
 #include <memory>
 
@@ -12,21 +14,40 @@ class Hierarchy {
 public:
     CubicBezierCurve curve;
     AABB box;
+    REAL t[2] = { 0.0, 1.0 };   /* parameter interval of the node on the root curve */
     std::shared_ptr<Hierarchy> left = nullptr;
     std::shared_ptr<Hierarchy> right = nullptr;
-    std::shared_ptr<Arc> arc = nullptr;
+    std::shared_ptr<VectorArc> arc = nullptr;
+    REAL error = 0.0;   /* approximation error of the leaf arc, the box is inflated by it */
 };
 
 AABB get_arc_aabb(const Arc *arc);
 
+// Computes boxes for an array of arcs in a single pass
+void get_arc_aabb(const Arc *arcs, AABB *boxes, int num_arcs);
+
+AABB get_arc_aabb(const VectorArc *arc);
+
+void get_arc_aabb(const VectorArc *arcs, AABB *boxes, int num_arcs);
+
+// Exact bounds from the endpoints and the extrema of each coordinate
+AABB get_curve_aabb(const QuadraticBezierCurve *curve);
+
+AABB get_curve_aabb(const LineSegment *line);
+
 CubicBezierCurve to_bezier(const Arc *arc);
 
+CubicBezierCurve to_bezier(const VectorArc *arc);
+
 REAL arc_approx_error_bound(const Arc *arc, const CubicBezierCurve *curve);
 
+REAL arc_approx_error_bound(const VectorArc *arc, const CubicBezierCurve *curve);
+
 REAL bezier_error_bound(const CubicBezierCurve *curve1, const CubicBezierCurve *curve2);
 
 AABB combine(const AABB &box1, const AABB &box2);
 
+// Drawing functions are defined in draw.cpp, which only the viewer links with OpenGL
 REAL get_AABB(const CubicBezierCurve &seg, const Arc arc, AABB& box, bool isDraw);
 
 void draw_AABB(const AABB &box);
@@ -34,3 +55,9 @@ void draw_AABB(const AABB &box);
 REAL distance(const AABB &box1, const AABB &box2);
 
 REAL volume(const AABB &box);
+
+REAL diameter(const AABB &box);
+
+bool test_aabb_collision(const AABB &box1, const AABB &box2);
+
+#endif /* _AABB_H_ */
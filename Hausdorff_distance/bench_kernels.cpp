@@ -0,0 +1,641 @@
+#include <benchmark/benchmark.h>
+#include "aabb.h"
+#include "biarc_approx.h"
+#include "primitive_distance.h"
+#include "hausdorff.h"
+#include "hierarchy.h"
+#include "rational.h"
+#include "corpus.h"
+
+#define NUM_CURVES 1024
+#define CORPUS_MASK (NUM_CURVES - 1)
+
+// Point is an array type, wrapped to be stored in a vector
+class Point2 {
+public:
+	Point pt;
+};
+
+// Corpus is built once per process from the fixed seed, leaf segments are taken at subdivision power 4
+class KernelCorpus {
+public:
+	std::vector<CubicBezierCurve> curves;
+	std::vector<PolynomialCurve> polynomials;
+	std::vector<CubicBezierCurve> segs;
+	std::vector<CubicBezierCurve> halves;
+	std::vector<Point2> points;
+	std::vector<Point2> inflects;
+	std::vector<Arc> arcs;
+	std::vector<VectorArc> vector_arcs;
+	std::vector<QuadraticBezierCurve> quadratics;
+	std::vector<LineSegment> lines;
+	std::vector<CubicBezierCurve> elevated_quadratics;
+	std::vector<CubicBezierCurve> elevated_lines;
+	std::vector<Bezier<3>> cubics;
+	std::vector<Bezier<5>> quintics;
+	std::vector<RationalBezier<2>> conics;
+
+	KernelCorpus(){
+		random_curves(CORPUS_SEED, NUM_CURVES, curves);
+		for (auto &curve: curves){
+			PolynomialCurve poly;
+			to_polynomial(&curve, &poly);
+			polynomials.push_back(poly);
+		}
+
+		std::vector<CubicBezierCurve> leaves;
+		for (auto &curve: curves){
+			leaves.clear();
+			subdivide(&curve, leaves, 4);
+			segs.push_back(leaves[(segs.size() * 7) % leaves.size()]);
+		}
+
+		std::mt19937 gen(CORPUS_SEED + 1);
+		std::uniform_real_distribution<REAL> coord(0.0, 1000.0);
+		for (auto &seg: segs){
+			Point2 p;
+			SET_PT2(p.pt, coord(gen), coord(gen));
+			points.push_back(p);
+
+			Point2 inflect;
+			get_biarc_inflect(&seg, inflect.pt);
+			inflects.push_back(inflect);
+
+			CubicBezierCurve half1, half2;
+			subdivide(&seg, &half1, &half2);
+			halves.push_back(half1);
+
+			Arc arc1, arc2;
+			to_biarc(&seg, inflect.pt, &arc1, &arc2);
+			arcs.push_back(arc1);
+
+			VectorArc varc1, varc2;
+			to_biarc(&seg, inflect.pt, &varc1, &varc2);
+			vector_arcs.push_back(varc1);
+		}
+
+		// Native quadratics and lines with their exact cubic elevations
+		for (size_t i = 0; i < NUM_CURVES; i++){
+			QuadraticBezierCurve quadratic;
+			for (int k = 0; k < 3; k++) SET_PT2(quadratic.control_pts[k], coord(gen), coord(gen));
+			quadratics.push_back(quadratic);
+			CubicBezierCurve cubic;
+			elevate(&quadratic, &cubic);
+			elevated_quadratics.push_back(cubic);
+
+			LineSegment line;
+			for (int k = 0; k < 2; k++) SET_PT2(line.control_pts[k], coord(gen), coord(gen));
+			lines.push_back(line);
+			elevate(&line, &cubic);
+			elevated_lines.push_back(cubic);
+		}
+
+		// Template curves, cubics are the corpus curves
+		for (size_t i = 0; i < NUM_CURVES; i++){
+			Bezier<3> cubic;
+			from_cubic(&curves[i], &cubic);
+			cubics.push_back(cubic);
+			Bezier<5> quintic;
+			for (int k = 0; k < 6; k++) SET_PT2(quintic.control_pts[k], coord(gen), coord(gen));
+			quintics.push_back(quintic);
+		}
+
+		// Exact conics of the biarc arcs, lines and wide arcs are skipped
+		for (auto &arc: vector_arcs){
+			RationalBezier<2> conic;
+			if (to_rational(&arc, &conic)) conics.push_back(conic);
+		}
+	}
+};
+
+static const KernelCorpus &corpus(){
+	static KernelCorpus kernel_corpus;
+	return kernel_corpus;
+}
+
+static void BM_evaluate(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point value;
+	for (auto _: state){
+		evaluate(&c.curves[i++ & CORPUS_MASK], 0.37, value);
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_evaluate);
+
+static void BM_evaluate_polynomial(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point value;
+	for (auto _: state){
+		evaluate(&c.polynomials[i++ & CORPUS_MASK], 0.37, value);
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_evaluate_polynomial);
+
+// Samples of one curve as drawn and as taken by sample_lower_bound
+static void BM_evaluate_samples(benchmark::State &state){
+	auto &c = corpus();
+	const int num_samples = state.range(0);
+	std::vector<REAL> xs(num_samples + 1), ys(num_samples + 1);
+	size_t i = 0;
+	for (auto _: state){
+		const CubicBezierCurve &curve = c.curves[i++ & CORPUS_MASK];
+		for (int j = 0; j <= num_samples; j++){
+			Point pt;
+			evaluate(&curve, (REAL)j / num_samples, pt);
+			xs[j] = pt[0];
+			ys[j] = pt[1];
+		}
+		benchmark::DoNotOptimize(xs.data());
+		benchmark::DoNotOptimize(ys.data());
+	}
+}
+BENCHMARK(BM_evaluate_samples)->Arg(10)->Arg(100);
+
+static void BM_evaluate_polynomial_samples(benchmark::State &state){
+	auto &c = corpus();
+	const int num_samples = state.range(0);
+	std::vector<REAL> xs(num_samples + 1), ys(num_samples + 1);
+	size_t i = 0;
+	for (auto _: state){
+		PolynomialCurve poly;
+		to_polynomial(&c.curves[i++ & CORPUS_MASK], &poly);
+		evaluate(&poly, num_samples, xs.data(), ys.data());
+		benchmark::DoNotOptimize(xs.data());
+		benchmark::DoNotOptimize(ys.data());
+	}
+}
+BENCHMARK(BM_evaluate_polynomial_samples)->Arg(10)->Arg(100);
+
+static void BM_evaluate_quadratic(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point value;
+	for (auto _: state){
+		evaluate(&c.quadratics[i++ & CORPUS_MASK], 0.37, value);
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_evaluate_quadratic);
+
+static void BM_evaluate_bezier(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point value;
+	for (auto _: state){
+		evaluate(&c.cubics[i++ & CORPUS_MASK], (REAL)0.37, value);
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_evaluate_bezier);
+
+static void BM_evaluate_bernstein(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point value;
+	for (auto _: state){
+		evaluate_bernstein(&c.cubics[i++ & CORPUS_MASK], (REAL)0.37, value);
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_evaluate_bernstein);
+
+static void BM_evaluate_quintic(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point value;
+	for (auto _: state){
+		evaluate(&c.quintics[i++ & CORPUS_MASK], (REAL)0.37, value);
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_evaluate_quintic);
+
+static void BM_evaluate_rational(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point value;
+	for (auto _: state){
+		evaluate(&c.conics[i++ % c.conics.size()], (REAL)0.37, value);
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_evaluate_rational);
+
+static void BM_subdivide_half(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	CubicBezierCurve output1, output2;
+	for (auto _: state){
+		subdivide(&c.curves[i++ & CORPUS_MASK], &output1, &output2);
+		benchmark::DoNotOptimize(output1);
+		benchmark::DoNotOptimize(output2);
+	}
+}
+BENCHMARK(BM_subdivide_half);
+
+static void BM_subdivide_t(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	CubicBezierCurve output1, output2;
+	for (auto _: state){
+		subdivide(&c.curves[i++ & CORPUS_MASK], 0.3, &output1, &output2);
+		benchmark::DoNotOptimize(output1);
+		benchmark::DoNotOptimize(output2);
+	}
+}
+BENCHMARK(BM_subdivide_t);
+
+static void BM_subcurve_by_endpoint(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		CubicBezierCurve output = subcurve_by_endpoint(c.curves[i++ & CORPUS_MASK], 0.3, 0.45);
+		benchmark::DoNotOptimize(output);
+	}
+}
+BENCHMARK(BM_subcurve_by_endpoint);
+
+static void BM_subcurve_polynomial(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	CubicBezierCurve output;
+	for (auto _: state){
+		subcurve(&c.polynomials[i++ & CORPUS_MASK], 0.3, 0.45, &output);
+		benchmark::DoNotOptimize(output);
+	}
+}
+BENCHMARK(BM_subcurve_polynomial);
+
+static void BM_subdivide_bezier(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Bezier<3> output1, output2;
+	for (auto _: state){
+		subdivide(&c.cubics[i++ & CORPUS_MASK], (REAL)0.3, &output1, &output2);
+		benchmark::DoNotOptimize(output1);
+		benchmark::DoNotOptimize(output2);
+	}
+}
+BENCHMARK(BM_subdivide_bezier);
+
+static void BM_subdivide_rational(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	RationalBezier<2> output1, output2;
+	for (auto _: state){
+		subdivide(&c.conics[i++ % c.conics.size()], (REAL)0.3, &output1, &output2);
+		benchmark::DoNotOptimize(output1);
+		benchmark::DoNotOptimize(output2);
+	}
+}
+BENCHMARK(BM_subdivide_rational);
+
+static void BM_subdivide_power(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	std::vector<CubicBezierCurve> output;
+	for (auto _: state){
+		output.clear();
+		subdivide(&c.curves[i++ & CORPUS_MASK], output, state.range(0));
+		benchmark::DoNotOptimize(output.data());
+	}
+	state.SetItemsProcessed(state.iterations() << state.range(0));
+}
+BENCHMARK(BM_subdivide_power)->Arg(2)->Arg(4)->Arg(6)->Arg(8);
+
+// Every leaf from its blossoms, items are leaves as in BM_subdivide_power
+static void BM_get_leaves(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	std::vector<CubicBezierCurve> output(1 << state.range(0));
+	for (auto _: state){
+		get_leaves(&c.curves[i++ & CORPUS_MASK], state.range(0), 0, output.size(), output.data());
+		benchmark::DoNotOptimize(output.data());
+	}
+	state.SetItemsProcessed(state.iterations() << state.range(0));
+}
+BENCHMARK(BM_get_leaves)->Arg(2)->Arg(4)->Arg(6)->Arg(8);
+
+// Single leaf in the middle, without the other leaves of its power
+static void BM_get_leaf(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	CubicBezierCurve output;
+	for (auto _: state){
+		get_leaf(&c.curves[i++ & CORPUS_MASK], state.range(0), (1 << state.range(0)) / 2 - 1, &output);
+		benchmark::DoNotOptimize(output);
+	}
+}
+BENCHMARK(BM_get_leaf)->Arg(4)->Arg(8);
+
+// Whole corpus in one structure of arrays, items are leaves as in BM_subdivide_power
+static void BM_subdivide_batch(benchmark::State &state){
+	auto &c = corpus();
+	CurveArray curves(NUM_CURVES << state.range(0));
+	for (auto _: state){
+		for (int i = 0; i < NUM_CURVES; i++) curves.set(i, &c.curves[i]);
+		curves.size = NUM_CURVES;
+		subdivide(curves, state.range(0));
+		benchmark::DoNotOptimize(curves.data.data());
+	}
+	state.SetItemsProcessed(state.iterations() * (NUM_CURVES << state.range(0)));
+}
+BENCHMARK(BM_subdivide_batch)->Arg(2)->Arg(4)->Arg(6)->Arg(8);
+
+static void BM_get_biarc_inflect(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point inflect;
+	for (auto _: state){
+		get_biarc_inflect(&c.segs[i++ & CORPUS_MASK], inflect);
+		benchmark::DoNotOptimize(inflect);
+	}
+}
+BENCHMARK(BM_get_biarc_inflect);
+
+static void BM_to_biarc(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Arc arc1, arc2;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		Point inflect = { c.inflects[j].pt[0], c.inflects[j].pt[1] };
+		to_biarc(&c.segs[j], inflect, &arc1, &arc2);
+		benchmark::DoNotOptimize(arc1);
+		benchmark::DoNotOptimize(arc2);
+	}
+}
+BENCHMARK(BM_to_biarc);
+
+static void BM_to_biarc_vector(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	VectorArc arc1, arc2;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		Point inflect = { c.inflects[j].pt[0], c.inflects[j].pt[1] };
+		to_biarc(&c.segs[j], inflect, &arc1, &arc2);
+		benchmark::DoNotOptimize(arc1);
+		benchmark::DoNotOptimize(arc2);
+	}
+}
+BENCHMARK(BM_to_biarc_vector);
+
+static void BM_get_arc_aabb(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		AABB box = get_arc_aabb(&c.arcs[i++ & CORPUS_MASK]);
+		benchmark::DoNotOptimize(box);
+	}
+}
+BENCHMARK(BM_get_arc_aabb);
+
+static void BM_get_arc_aabb_vector(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		AABB box = get_arc_aabb(&c.vector_arcs[i++ & CORPUS_MASK]);
+		benchmark::DoNotOptimize(box);
+	}
+}
+BENCHMARK(BM_get_arc_aabb_vector);
+
+static void BM_get_arc_aabb_batch(benchmark::State &state){
+	auto &c = corpus();
+	std::vector<AABB> boxes(NUM_CURVES);
+	for (auto _: state){
+		get_arc_aabb(c.arcs.data(), boxes.data(), NUM_CURVES);
+		benchmark::DoNotOptimize(boxes.data());
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_CURVES);
+}
+BENCHMARK(BM_get_arc_aabb_batch);
+
+static void BM_get_arc_aabb_vector_batch(benchmark::State &state){
+	auto &c = corpus();
+	std::vector<AABB> boxes(NUM_CURVES);
+	for (auto _: state){
+		get_arc_aabb(c.vector_arcs.data(), boxes.data(), NUM_CURVES);
+		benchmark::DoNotOptimize(boxes.data());
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_CURVES);
+}
+BENCHMARK(BM_get_arc_aabb_vector_batch);
+
+static void BM_arc_approx_error_bound(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL error = arc_approx_error_bound(&c.arcs[j], &c.halves[j]);
+		benchmark::DoNotOptimize(error);
+	}
+}
+BENCHMARK(BM_arc_approx_error_bound);
+
+static void BM_arc_approx_error_bound_vector(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL error = arc_approx_error_bound(&c.vector_arcs[j], &c.halves[j]);
+		benchmark::DoNotOptimize(error);
+	}
+}
+BENCHMARK(BM_arc_approx_error_bound_vector);
+
+static void BM_rational_error_bound(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL error = rational_error_bound(&c.halves[j], &c.conics[j % c.conics.size()]);
+		benchmark::DoNotOptimize(error);
+	}
+}
+BENCHMARK(BM_rational_error_bound);
+
+static void BM_distance_lower_bound(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL bound = distance_lower_bound(c.points[j].pt, c.curves[j]);
+		benchmark::DoNotOptimize(bound);
+	}
+}
+BENCHMARK(BM_distance_lower_bound);
+
+static void BM_projection(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL t = projection(c.points[j].pt, c.curves[j]);
+		benchmark::DoNotOptimize(t);
+	}
+}
+BENCHMARK(BM_projection);
+
+static void BM_sample_lower_bound(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point pt1, pt2;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL bound = sample_lower_bound(c.segs[j], c.curves[j], 10, pt1, pt2);
+		benchmark::DoNotOptimize(bound);
+	}
+}
+BENCHMARK(BM_sample_lower_bound);
+
+static void BM_projection_quadratic(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL t = projection(c.points[j].pt, c.quadratics[j]);
+		benchmark::DoNotOptimize(t);
+	}
+}
+BENCHMARK(BM_projection_quadratic);
+
+// Same query through the generic cubic search on the elevated curve
+static void BM_projection_elevated_quadratic(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL t = projection(c.points[j].pt, c.elevated_quadratics[j]);
+		benchmark::DoNotOptimize(t);
+	}
+}
+BENCHMARK(BM_projection_elevated_quadratic);
+
+static void BM_projection_line(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL t = projection(c.points[j].pt, c.lines[j]);
+		benchmark::DoNotOptimize(t);
+	}
+}
+BENCHMARK(BM_projection_line);
+
+static void BM_projection_elevated_line(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL t = projection(c.points[j].pt, c.elevated_lines[j]);
+		benchmark::DoNotOptimize(t);
+	}
+}
+BENCHMARK(BM_projection_elevated_line);
+
+static void BM_projection_bezier(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL t = projection(c.points[j].pt, c.cubics[j]);
+		benchmark::DoNotOptimize(t);
+	}
+}
+BENCHMARK(BM_projection_bezier);
+
+static void BM_projection_quintic(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++ & CORPUS_MASK;
+		REAL t = projection(c.points[j].pt, c.quintics[j]);
+		benchmark::DoNotOptimize(t);
+	}
+}
+BENCHMARK(BM_projection_quintic);
+
+static void BM_intersection_quintic(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	std::vector<BezierIntersection<REAL>> output;
+	for (auto _: state){
+		size_t j = i++;
+		output.clear();
+		intersection(c.quintics[j & CORPUS_MASK], c.quintics[(j * 7 + 1) & CORPUS_MASK], output);
+		benchmark::DoNotOptimize(output.data());
+	}
+}
+BENCHMARK(BM_intersection_quintic);
+
+// Elevated lines stop at the root, leaves of general curves are fitted with biarcs
+static void BM_build_hierarchy_line(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		auto tree = std::make_shared<Hierarchy>();
+		tree->curve = c.elevated_lines[i++ & CORPUS_MASK];
+		build_hierarchy(tree, state.range(0));
+		benchmark::DoNotOptimize(tree.get());
+	}
+}
+BENCHMARK(BM_build_hierarchy_line)->Arg(4)->Arg(8);
+
+static void BM_build_hierarchy_curve(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		auto tree = std::make_shared<Hierarchy>();
+		tree->curve = c.curves[i++ & CORPUS_MASK];
+		build_hierarchy(tree, state.range(0));
+		benchmark::DoNotOptimize(tree.get());
+	}
+}
+BENCHMARK(BM_build_hierarchy_curve)->Arg(4)->Arg(8);
+
+// Arc pair distance without witnesses, distance of two Arc draws them with OpenGL and is not measured here
+static void BM_arc_distance(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	for (auto _: state){
+		size_t j = i++;
+		REAL d = distance(c.vector_arcs[j & CORPUS_MASK], c.vector_arcs[(j * 7 + 1) & CORPUS_MASK]);
+		benchmark::DoNotOptimize(d);
+	}
+}
+BENCHMARK(BM_arc_distance);
+
+static void BM_primitive_distance(benchmark::State &state){
+	auto &c = corpus();
+	size_t i = 0;
+	Point witness1, witness2;
+	for (auto _: state){
+		size_t j = i++;
+		REAL d = distance(c.vector_arcs[j & CORPUS_MASK], c.vector_arcs[(j * 7 + 1) & CORPUS_MASK], witness1, witness2);
+		benchmark::DoNotOptimize(d);
+	}
+}
+BENCHMARK(BM_primitive_distance);
+
+static void BM_primitive_distance_batch(benchmark::State &state){
+	auto &c = corpus();
+	std::vector<VectorArc> prims2(NUM_CURVES);
+	for (size_t j = 0; j < NUM_CURVES; j++){
+		prims2[j] = c.vector_arcs[(j * 7 + 1) & CORPUS_MASK];
+	}
+	std::vector<REAL> output(NUM_CURVES);
+	for (auto _: state){
+		distance(c.vector_arcs.data(), prims2.data(), NUM_CURVES, output.data());
+		benchmark::DoNotOptimize(output.data());
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_CURVES);
+}
+BENCHMARK(BM_primitive_distance_batch);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <chrono>
+#include "path.h"
+#include "corpus.h"
+
+#define PATH_POWER 4
+#define SEGMENT_SIZE 100.0
+#define MAX_BRUTE_FORCE 256
+#define MAX_SAMPLED 64
+#define SAMPLES_PER_SEGMENT 100
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_ms(bench_clock::time_point begin){
+	return std::chrono::duration<double, std::milli>(bench_clock::now() - begin).count();
+}
+
+static REAL distance_to_polyline(const Point &p, const std::vector<REAL> &xs, const std::vector<REAL> &ys){
+	REAL min_dist = std::numeric_limits<REAL>::max();
+	for (int i = 0; i + 1 < xs.size(); i++){
+		Point p1 = { xs[i], ys[i] }, p2 = { xs[i + 1], ys[i + 1] };
+		Point d, v;
+		subtract_point(p2, p1, d);
+		subtract_point(p, p1, v);
+		REAL len2 = d[0] * d[0] + d[1] * d[1];
+		REAL s = len2 > 0.0 ? std::max((REAL)0.0, std::min((REAL)1.0, (v[0] * d[0] + v[1] * d[1]) / len2)) : 0.0;
+		Point closest = { p1[0] + s * d[0], p1[1] + s * d[1] };
+		min_dist = std::min(min_dist, distance(p, closest));
+	}
+	return min_dist;
+}
+
+// Hausdorff distance of dense polylines of both paths
+static REAL sampled_hausdorff(const BezierPath &path1, const BezierPath &path2){
+	std::vector<REAL> xs[2], ys[2];
+	const BezierPath *paths[2] = { &path1, &path2 };
+	for (int k = 0; k < 2; k++){
+		int n = num_segments(*paths[k]) * SAMPLES_PER_SEGMENT;
+		for (int i = 0; i <= n; i++){
+			Point pt;
+			evaluate(*paths[k], (REAL)i / SAMPLES_PER_SEGMENT, pt);
+			xs[k].push_back(pt[0]);
+			ys[k].push_back(pt[1]);
+		}
+	}
+	REAL max_dist = 0.0;
+	for (int k = 0; k < 2; k++){
+		for (int i = 0; i < xs[k].size(); i++){
+			Point pt = { xs[k][i], ys[k][i] };
+			max_dist = std::max(max_dist, distance_to_polyline(pt, xs[1 - k], ys[1 - k]));
+		}
+	}
+	return max_dist;
+}
+
+// Queries on two paths with one hierarchy each, against the same queries on every pair of their segments
+int main(int argc, char *argv[])
+{
+	printf("%8s | %10s %10s | %12s %12s %10s | %10s %8s %12s %8s | %12s %10s %10s\n", "segments",
+		"build(ms)", "segs(ms)", "mindist(ms)", "pairwise(ms)", "diff",
+		"inter(ms)", "found", "pairwise(ms)", "found", "hausdorff(ms)", "distance", "sampled");
+	for (int n = 16; n <= 1024; n *= 4){
+		std::vector<CubicBezierCurve> curves1, curves2;
+		random_path(CORPUS_SEED, n, SEGMENT_SIZE, curves1);
+		random_path(CORPUS_SEED + 1, n, SEGMENT_SIZE, curves2);
+		// Paths start at the same point, path2 is shifted by the spread of a random walk for minimum distance
+		std::vector<CubicBezierCurve> curves3 = curves2;
+		for (auto &curve: curves3){
+			for (int j = 0; j < 4; j++) curve.control_pts[j][0] += SEGMENT_SIZE * std::sqrt((REAL)n);
+		}
+		BezierPath path1, path2, path3;
+		for (auto &curve: curves1) append_segment(path1, curve);
+		for (auto &curve: curves2) append_segment(path2, curve);
+		for (auto &curve: curves3) append_segment(path3, curve);
+
+		auto tree1 = std::make_shared<Hierarchy>();
+		auto tree2 = std::make_shared<Hierarchy>();
+		auto tree3 = std::make_shared<Hierarchy>();
+		build_hierarchy(tree3, path3, PATH_POWER);
+		auto begin = bench_clock::now();
+		build_hierarchy(tree1, path1, PATH_POWER);
+		build_hierarchy(tree2, path2, PATH_POWER);
+		double build_ms = elapsed_ms(begin);
+
+		// Separate hierarchy per segment, with path parameters so that intersections are comparable
+		std::vector<std::shared_ptr<Hierarchy>> segs1, segs2, segs3;
+		begin = bench_clock::now();
+		for (int i = 0; i < n; i++){
+			segs1.push_back(std::make_shared<Hierarchy>());
+			segs2.push_back(std::make_shared<Hierarchy>());
+			segs1[i]->curve = curves1[i];
+			segs2[i]->curve = curves2[i];
+			segs1[i]->t[0] = segs2[i]->t[0] = i;
+			segs1[i]->t[1] = segs2[i]->t[1] = i + 1;
+			build_hierarchy(segs1[i], PATH_POWER);
+			build_hierarchy(segs2[i], PATH_POWER);
+		}
+		double segs_ms = elapsed_ms(begin);
+		for (int i = 0; i < n; i++){
+			segs3.push_back(std::make_shared<Hierarchy>());
+			segs3[i]->curve = curves3[i];
+			build_hierarchy(segs3[i], PATH_POWER);
+		}
+
+		MinDistanceResult result;
+		begin = bench_clock::now();
+		REAL dist = minimum_distance(tree1, tree3, result);
+		double dist_ms = elapsed_ms(begin);
+
+		std::vector<PathIntersection> inters;
+		begin = bench_clock::now();
+		intersection(tree1, tree2, inters);
+		double inter_ms = elapsed_ms(begin);
+
+		HausdorffResult hausdorff;
+		begin = bench_clock::now();
+		REAL hausdorff_dist = hausdorff_distance(path1, tree1, path2, tree2, hausdorff);
+		double hausdorff_ms = elapsed_ms(begin);
+
+		char sampled[16] = "-";
+		if (n <= MAX_SAMPLED) snprintf(sampled, sizeof(sampled), "%10.4f", sampled_hausdorff(path1, path2));
+
+		if (n > MAX_BRUTE_FORCE){
+			printf("%8d | %10.2f %10.2f | %12.2f %12s %10s | %10.2f %8zu %12s %8s | %12.2f %10.4f %10s\n", n,
+				build_ms, segs_ms, dist_ms, "-", "-", inter_ms, inters.size(), "-", "-", hausdorff_ms, hausdorff_dist, sampled);
+			continue;
+		}
+
+		REAL brute_dist = std::numeric_limits<REAL>::max();
+		begin = bench_clock::now();
+		for (int i = 0; i < n; i++){
+			for (int j = 0; j < n; j++){
+				MinDistanceResult pair;
+				brute_dist = std::min(brute_dist, minimum_distance(segs1[i], segs3[j], pair));
+			}
+		}
+		double brute_dist_ms = elapsed_ms(begin);
+
+		// Crossings on a shared segment endpoint are found by both segments
+		std::vector<PathIntersection> brute_inters;
+		begin = bench_clock::now();
+		for (int i = 0; i < n; i++){
+			for (int j = 0; j < n; j++){
+				intersection(segs1[i], segs2[j], brute_inters);
+			}
+		}
+		double brute_inter_ms = elapsed_ms(begin);
+
+		printf("%8d | %10.2f %10.2f | %12.2f %12.2f %10.2e | %10.2f %8zu %12.2f %8zu | %12.2f %10.4f %10s\n", n,
+			build_ms, segs_ms, dist_ms, brute_dist_ms, std::abs(dist - brute_dist),
+			inter_ms, inters.size(), brute_inter_ms, brute_inters.size(), hausdorff_ms, hausdorff_dist, sampled);
+	}
+
+	return 0;
+}
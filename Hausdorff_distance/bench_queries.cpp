@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <chrono>
+#include <algorithm>
+#include "hierarchy.h"
+#include "hausdorff.h"
+#include "corpus.h"
+
+#define NUM_PAIRS 100
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_us(bench_clock::time_point begin){
+	return std::chrono::duration<double, std::micro>(bench_clock::now() - begin).count();
+}
+
+// Latencies of one query over the corpus, with the error reported by the query (half of its final gap)
+// and its search statistics, queries without a search leave both empty
+class QueryStats {
+public:
+	std::vector<double> latency;
+	std::vector<REAL> error;
+	std::vector<SearchStats> search;
+
+	void add(double us){
+		latency.push_back(us);
+	}
+
+	void add(double us, REAL err, const SearchStats &stats){
+		latency.push_back(us);
+		error.push_back(err);
+		search.push_back(stats);
+	}
+
+	void print(const char *kind, const char *query, int power){
+		std::vector<double> sorted(latency);
+		std::sort(sorted.begin(), sorted.end());
+		double total = 0.0;
+		for (double us: sorted) total += us;
+		printf("%6s %10s %5d | %12.1f %10.2f %10.2f %10.2f |", kind, query, power,
+			1e6 * sorted.size() / total, percentile(sorted, 0.5), percentile(sorted, 0.9), percentile(sorted, 0.99));
+
+		if (error.empty()){
+			printf(" %12s %12s %8s | %8s %8s %8s %8s %10s\n", "-", "-", "-", "-", "-", "-", "-", "-");
+			return;
+		}
+		// Negative error means the upper bound ended below the lower bound
+		REAL mean_error = 0.0, max_error = 0.0;
+		int inverted = 0;
+		for (REAL err: error){
+			mean_error += std::abs(err);
+			max_error = std::max(max_error, std::abs(err));
+			if (err < 0.0) inverted++;
+		}
+		mean_error /= error.size();
+		printf(" %12.3e %12.3e %8d |", mean_error, max_error, inverted);
+
+		double pops = 0.0, pruned = 0.0, max_queue = 0.0, leaf_tests = 0.0, first_upper_bound_us = 0.0;
+		for (auto &stats: search){
+			pops += stats.pops;
+			pruned += stats.pruned;
+			max_queue += stats.max_queue_size;
+			leaf_tests += stats.leaf_tests;
+			first_upper_bound_us += stats.first_upper_bound_us;
+		}
+		printf(" %8.1f %8.1f %8.1f %8.1f %10.2f\n", pops / search.size(), pruned / search.size(), max_queue / search.size(),
+			leaf_tests / search.size(), first_upper_bound_us / search.size());
+	}
+
+private:
+	static double percentile(const std::vector<double> &sorted, double q){
+		size_t idx = (size_t)(q * (sorted.size() - 1) + 0.5);
+		return sorted[idx];
+	}
+};
+
+// "--trace file" writes a CSV convergence trace of every minimum distance and Hausdorff query,
+// "--trace-binary file" writes the same in binary (search_trace.h),
+// "--max-pops n" and "--time-limit-us t" run those queries in anytime mode with the given budget, 0 is no limit
+int main(int argc, char *argv[])
+{
+	FILE *trace_file = nullptr;
+	std::shared_ptr<SearchTrace> trace;
+	std::shared_ptr<SearchBudget> budget;
+	for (int i = 1; i + 1 < argc; i += 2){
+		std::string option = argv[i];
+		if (option == "--max-pops" || option == "--time-limit-us"){
+			if (!budget) budget = std::make_shared<SearchBudget>();
+			if (option == "--max-pops") budget->max_pops = atol(argv[i + 1]);
+			else budget->time_limit_us = atof(argv[i + 1]);
+			continue;
+		}
+		if (option != "--trace" && option != "--trace-binary") continue;
+		trace_file = fopen(argv[i + 1], option == "--trace" ? "w" : "wb");
+		if (trace_file == nullptr){
+			fprintf(stderr, "Can not open %s\n", argv[i + 1]);
+			return 1;
+		}
+		trace = std::make_shared<SearchTrace>(trace_file, option == "--trace" ? TRACE_CSV : TRACE_BINARY);
+	}
+
+	printf("%6s %10s %5s | %12s %10s %10s %10s | %12s %12s %8s | %8s %8s %8s %8s %10s\n", "corpus", "query", "power",
+		"queries/s", "p50(us)", "p90(us)", "p99(us)", "mean error", "max error", "inverted",
+		"pops", "pruned", "max q", "leaves", "first(us)");
+	for (int k = 0; k < NUM_PAIR_KINDS; k++){
+		PairKind kind = (PairKind)k;
+		std::vector<CubicBezierCurve> curves1, curves2;
+		random_pairs(CORPUS_SEED, kind, NUM_PAIRS, curves1, curves2);
+
+		for (int power = 2; power <= 8; power += 2){
+			QueryStats build, mindist, inter;
+			for (int i = 0; i < NUM_PAIRS; i++){
+				auto root1 = std::make_shared<Hierarchy>();
+				auto root2 = std::make_shared<Hierarchy>();
+				root1->curve = curves1[i];
+				root2->curve = curves2[i];
+
+				auto begin = bench_clock::now();
+				build_hierarchy(root1, power);
+				build_hierarchy(root2, power);
+				build.add(elapsed_us(begin));
+
+				MinDistanceResult result;
+				SearchStats stats(trace.get());
+				begin = bench_clock::now();
+				minimum_distance(root1, root2, result, &stats, budget.get());
+				mindist.add(elapsed_us(begin), (result.upper_bound - result.lower_bound) / 2.0, stats);
+
+				std::vector<curve_pair> output;
+				begin = bench_clock::now();
+				intersection(root1, root2, output);
+				inter.add(elapsed_us(begin));
+			}
+			build.print(pair_kind_name(kind), "build", power);
+			mindist.print(pair_kind_name(kind), "mindist", power);
+			inter.print(pair_kind_name(kind), "inter", power);
+		}
+
+		// Hausdorff distance works on the curves directly, there is no subdivision power
+		QueryStats hausdorff;
+		for (int i = 0; i < NUM_PAIRS; i++){
+			HausdorffResult result;
+			SearchStats stats(trace.get());
+			auto begin = bench_clock::now();
+			hausdorff_distance(curves1[i], curves2[i], result, &stats, budget.get());
+			hausdorff.add(elapsed_us(begin), (result.upper_bound - result.lower_bound) / 2.0, stats);
+		}
+		hausdorff.print(pair_kind_name(kind), "hausdorff", 0);
+	}
+
+	if (trace_file) fclose(trace_file);
+	return 0;
+}
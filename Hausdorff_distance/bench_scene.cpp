@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include "scene.h"
+#include "corpus.h"
+
+#define SCENE_POWER 4
+#define CURVE_SIZE 10.0
+#define MAX_BRUTE_FORCE 256
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_ms(bench_clock::time_point begin){
+	return std::chrono::duration<double, std::milli>(bench_clock::now() - begin).count();
+}
+
+// Closest pair of the scene against minimum distance of every pair of curves, and intersections of a denser scene
+// against intersection of every pair of curves
+int main(int argc, char *argv[])
+{
+	printf("%7s | %10s %12s | %12s %12s | %10s\n", "curves", "build(ms)", "closest(ms)", "pairwise(ms)", "distance", "diff");
+	for (int num_curves = 64; num_curves <= 16384; num_curves *= 4){
+		// Density is kept constant, extent grows with the square root of the number of curves
+		std::vector<CubicBezierCurve> curves;
+		random_scene(CORPUS_SEED, num_curves, CURVE_SIZE, 20.0 * CURVE_SIZE * std::sqrt((REAL)num_curves), curves);
+
+		Scene scene;
+		auto begin = bench_clock::now();
+		build_scene(scene, curves, SCENE_POWER);
+		double build_ms = elapsed_ms(begin);
+
+		SceneDistanceResult result;
+		begin = bench_clock::now();
+		REAL dist = minimum_distance(scene, result);
+		double closest_ms = elapsed_ms(begin);
+
+		if (num_curves > MAX_BRUTE_FORCE){
+			printf("%7d | %10.2f %12.2f | %12s %12.4f | %10s\n", num_curves, build_ms, closest_ms, "-", dist, "-");
+			continue;
+		}
+
+		REAL brute_dist = std::numeric_limits<REAL>::max();
+		begin = bench_clock::now();
+		for (int i = 0; i < num_curves; i++){
+			for (int j = i + 1; j < num_curves; j++){
+				MinDistanceResult pair;
+				brute_dist = std::min(brute_dist, minimum_distance(scene.trees[i], scene.trees[j], pair));
+			}
+		}
+		double brute_ms = elapsed_ms(begin);
+		printf("%7d | %10.2f %12.2f | %12.2f %12.4f | %10.2e\n", num_curves, build_ms, closest_ms, brute_ms, dist, std::abs(dist - brute_dist));
+	}
+
+	int num_threads = std::max(1u, std::thread::hardware_concurrency());
+	printf("\n%7s | %12s %12s | %12s | %12s %10s\n", "curves", "inter(ms)", "threads(ms)", "found", "pairwise(ms)", "diff");
+	for (int num_curves = 64; num_curves <= 16384; num_curves *= 4){
+		std::vector<CubicBezierCurve> curves;
+		random_scene(CORPUS_SEED, num_curves, CURVE_SIZE, 4.0 * CURVE_SIZE * std::sqrt((REAL)num_curves), curves);
+		Scene scene;
+		build_scene(scene, curves, SCENE_POWER);
+
+		std::vector<SceneIntersection> output;
+		auto begin = bench_clock::now();
+		intersection(scene, output, 1);
+		double inter_ms = elapsed_ms(begin);
+
+		std::vector<SceneIntersection> thread_output;
+		begin = bench_clock::now();
+		intersection(scene, thread_output, num_threads);
+		double thread_ms = elapsed_ms(begin);
+
+		if (num_curves > MAX_BRUTE_FORCE){
+			printf("%7d | %12.2f %12.2f | %12zu | %12s %10s\n", num_curves, inter_ms, thread_ms, output.size(), "-", "-");
+			continue;
+		}
+
+		std::vector<SceneIntersection> brute_output;
+		begin = bench_clock::now();
+		for (int i = 0; i < num_curves; i++){
+			for (int j = i + 1; j < num_curves; j++){
+				intersection(scene, i, j, brute_output);
+			}
+		}
+		double brute_ms = elapsed_ms(begin);
+		printf("%7d | %12.2f %12.2f | %12zu | %12.2f %10d\n", num_curves, inter_ms, thread_ms, output.size(), brute_ms,
+			(int)brute_output.size() - (int)output.size());
+	}
+
+	return 0;
+}
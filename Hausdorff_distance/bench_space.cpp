@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <chrono>
+#include <array>
+#include "bezier_tree.h"
+#include "corpus.h"
+
+#define NUM_PAIRS 100
+#define NUM_SAMPLES 1000
+#define CONTACT_TOLERANCE 1e-2
+
+typedef std::chrono::steady_clock bench_clock;
+typedef Bezier<3, REAL, 3> SpaceCurve;
+typedef BezierTree<3, REAL, 3> SpaceTree;
+
+double elapsed_ms(bench_clock::time_point begin){
+	return std::chrono::duration<double, std::milli>(bench_clock::now() - begin).count();
+}
+
+static void sample_curve(const SpaceCurve &curve, std::vector<std::array<REAL, 3>> &output){
+	for (int i = 0; i <= NUM_SAMPLES; i++){
+		std::array<REAL, 3> p;
+		evaluate(&curve, (REAL)i / NUM_SAMPLES, p.data());
+		output.push_back(p);
+	}
+}
+
+static REAL sampled_minimum_distance(const std::vector<std::array<REAL, 3>> &pts1, const std::vector<std::array<REAL, 3>> &pts2){
+	REAL min_dist = std::numeric_limits<REAL>::max();
+	for (auto &p1: pts1){
+		for (auto &p2: pts2) min_dist = std::min(min_dist, point_distance_nd<REAL, 3>(p1.data(), p2.data()));
+	}
+	return min_dist;
+}
+
+// Hausdorff distance of the polylines through the samples
+static REAL sampled_hausdorff(const std::vector<std::array<REAL, 3>> &pts1, const std::vector<std::array<REAL, 3>> &pts2){
+	const std::vector<std::array<REAL, 3>> *pts[2] = { &pts1, &pts2 };
+	REAL max_dist = 0.0;
+	for (int k = 0; k < 2; k++){
+		const auto &source = *pts[k], &target = *pts[1 - k];
+		for (auto &p: source){
+			REAL min_dist = std::numeric_limits<REAL>::max();
+			for (int i = 0; i + 1 < target.size(); i++){
+				REAL s;
+				min_dist = std::min(min_dist, point_segment_distance<REAL, 3>(p.data(), target[i].data(), target[i + 1].data(), s));
+			}
+			max_dist = std::max(max_dist, min_dist);
+		}
+	}
+	return max_dist;
+}
+
+// Queries on cubic space curves with BezierTree, against dense sampling. Second curves of the contact pairs are
+// moved so that they pass through a point of the first curve
+int main(int argc, char *argv[])
+{
+	std::vector<SpaceCurve> curves1, curves2;
+	random_space_curves(CORPUS_SEED, NUM_PAIRS, curves1);
+	random_space_curves(CORPUS_SEED + 1, NUM_PAIRS, curves2);
+	std::vector<SpaceCurve> touching = curves2;
+	std::mt19937 gen(CORPUS_SEED);
+	std::uniform_real_distribution<REAL> unit(0.1, 0.9);
+	for (int i = 0; i < NUM_PAIRS; i++){
+		REAL p1[3], p2[3];
+		evaluate(&curves1[i], unit(gen), p1);
+		evaluate(&touching[i], unit(gen), p2);
+		for (int j = 0; j <= 3; j++){
+			for (int k = 0; k < 3; k++) touching[i].control_pts[j][k] += p1[k] - p2[k];
+		}
+	}
+
+	std::vector<std::vector<std::array<REAL, 3>>> samples1(NUM_PAIRS), samples2(NUM_PAIRS);
+	auto begin = bench_clock::now();
+	REAL sampled_min[NUM_PAIRS], sampled_max[NUM_PAIRS];
+	for (int i = 0; i < NUM_PAIRS; i++){
+		sample_curve(curves1[i], samples1[i]);
+		sample_curve(curves2[i], samples2[i]);
+		sampled_min[i] = sampled_minimum_distance(samples1[i], samples2[i]);
+	}
+	const double sampled_min_ms = elapsed_ms(begin);
+	begin = bench_clock::now();
+	for (int i = 0; i < NUM_PAIRS; i++) sampled_max[i] = sampled_hausdorff(samples1[i], samples2[i]);
+	const double sampled_max_ms = elapsed_ms(begin);
+	printf("sampled: mindist %.3f ms, hausdorff %.3f ms for %d pairs at %d samples\n\n", sampled_min_ms, sampled_max_ms, NUM_PAIRS, NUM_SAMPLES);
+
+	printf("%6s | %10s | %12s %10s %10s | %10s %8s | %13s %10s\n", "power",
+		"build(ms)", "mindist(ms)", "diff", "gap", "inter(ms)", "found", "hausdorff(ms)", "diff");
+	for (int power = 2; power <= 8; power += 2){
+		std::vector<std::shared_ptr<SpaceTree>> trees1, trees2, trees3;
+		begin = bench_clock::now();
+		for (int i = 0; i < NUM_PAIRS; i++){
+			trees1.push_back(std::make_shared<SpaceTree>());
+			trees1.back()->curve = curves1[i];
+			build_hierarchy(trees1.back(), power);
+			trees2.push_back(std::make_shared<SpaceTree>());
+			trees2.back()->curve = curves2[i];
+			build_hierarchy(trees2.back(), power);
+		}
+		const double build_ms = elapsed_ms(begin) / 2;
+		for (int i = 0; i < NUM_PAIRS; i++){
+			trees3.push_back(std::make_shared<SpaceTree>());
+			trees3.back()->curve = touching[i];
+			build_hierarchy(trees3.back(), power);
+		}
+
+		// Sampled distance is above the true one by up to the sample spacing
+		begin = bench_clock::now();
+		REAL min_diff = 0.0, gap = 0.0;
+		for (int i = 0; i < NUM_PAIRS; i++){
+			BezierDistanceResult<REAL, 3> result;
+			minimum_distance(trees1[i], trees2[i], result);
+			min_diff = std::max(min_diff, std::abs(result.upper_bound - sampled_min[i]));
+			gap = std::max(gap, result.upper_bound - result.lower_bound);
+		}
+		const double min_ms = elapsed_ms(begin);
+
+		begin = bench_clock::now();
+		int found = 0;
+		for (int i = 0; i < NUM_PAIRS; i++){
+			std::vector<BezierIntersection<REAL, 3>> contacts;
+			intersection(trees1[i], trees3[i], (REAL)CONTACT_TOLERANCE, contacts);
+			found += !contacts.empty();
+		}
+		const double inter_ms = elapsed_ms(begin);
+
+		// Hausdorff distance does not use the trees, it is timed once per power for a stable table
+		begin = bench_clock::now();
+		REAL max_diff = 0.0;
+		for (int i = 0; i < NUM_PAIRS; i++){
+			BezierDistanceResult<REAL, 3> result;
+			REAL d = hausdorff_distance(curves1[i], curves2[i], result);
+			max_diff = std::max(max_diff, std::abs(d - sampled_max[i]));
+		}
+		const double max_ms = elapsed_ms(begin);
+
+		printf("%6d | %10.3f | %12.3f %10.4f %10.4f | %10.3f %4d/%3d | %13.3f %10.4f\n", power,
+			build_ms, min_ms, min_diff, gap, inter_ms, found, NUM_PAIRS, max_ms, max_diff);
+	}
+	return 0;
+}
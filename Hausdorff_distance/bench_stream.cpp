@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <chrono>
+#include <sys/resource.h>
+#include "curve_file.h"
+#include "corpus.h"
+#include "text_import.h"
+
+#define CURVES_PER_BATCH 10000
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_ms(bench_clock::time_point begin){
+	return std::chrono::duration<double, std::milli>(bench_clock::now() - begin).count();
+}
+
+static long peak_rss_kb(){
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+// Writes num_curves random curves in the text format of the viewer, generated in batches to keep memory flat
+static void write_input(const char *path, long num_curves){
+	FILE *f = fopen(path, "w");
+	for (long i = 0; i < num_curves; i += CURVES_PER_BATCH){
+		std::vector<CubicBezierCurve> curves;
+		random_curves(CORPUS_SEED + i, std::min((long)CURVES_PER_BATCH, num_curves - i), curves);
+		for (auto &curve: curves){
+			for (int j = 0; j < 4; j++) fprintf(f, "%.9g %.9g\n", curve.control_pts[j][0], curve.control_pts[j][1]);
+		}
+	}
+	fclose(f);
+}
+
+// Streaming pipeline on growing inputs, peak RSS is the maximum over the process so far and should stay flat.
+// Last row loads the largest input at once and converts it, for comparison. Second table compares loading it from text
+// with mapping the binary curve file
+int main(int argc, char *argv[])
+{
+	const char *input_path = "bench_stream.in";
+	const char *output_path = "bench_stream.out";
+	printf("%10s | %10s %10s %10s | %12s\n", "curves", "input(MB)", "time(ms)", "MB/s", "peak RSS(MB)");
+
+	long num_curves = 10000;
+	for (; num_curves <= 1000000; num_curves *= 10){
+		write_input(input_path, num_curves);
+		FILE *input = fopen(input_path, "r");
+		FILE *output = fopen(output_path, "w");
+		StreamStats stats;
+		auto begin = bench_clock::now();
+		bool valid = process_stream(input, output, stats);
+		double ms = elapsed_ms(begin);
+		fclose(input);
+		fclose(output);
+
+		double mb = stats.bytes_read / 1048576.0;
+		printf("%10ld | %10.1f %10.1f %10.1f | %12.1f%s\n", stats.curves, mb, ms, mb / (ms / 1000.0), peak_rss_kb() / 1024.0,
+			valid && stats.curves == num_curves ? "" : " (invalid)");
+	}
+
+	num_curves /= 10;
+	FILE *input = fopen(input_path, "r");
+	FILE *output = fopen(output_path, "w");
+	auto begin = bench_clock::now();
+	std::vector<CubicBezierCurve> curves;
+	CubicBezierCurve curve;
+	while (fscanf(input, "%f %f %f %f %f %f %f %f", &curve.control_pts[0][0], &curve.control_pts[0][1], &curve.control_pts[1][0], &curve.control_pts[1][1],
+		&curve.control_pts[2][0], &curve.control_pts[2][1], &curve.control_pts[3][0], &curve.control_pts[3][1]) == 8){
+		curves.push_back(curve);
+	}
+	std::vector<StreamRecord> records(curves.size());
+	for (int i = 0; i < curves.size(); i++) convert_curve(curves[i], records[i]);
+	for (auto &record: records) write_record(output, record);
+	double ms = elapsed_ms(begin);
+	fclose(input);
+	fclose(output);
+	printf("%10zu | %10s %10.1f %10s | %12.1f (in memory)\n", curves.size(), "-", ms, "-", peak_rss_kb() / 1024.0);
+
+	// Loading the same curves from text against mapping the binary file and gathering them, records are compared in place
+	const char *binary_path = "bench_stream.bin";
+	write_curve_file(binary_path, curves, records.data());
+	input = fopen(input_path, "r");
+	begin = bench_clock::now();
+	std::vector<CubicBezierCurve> parsed;
+	while (fscanf(input, "%f %f %f %f %f %f %f %f", &curve.control_pts[0][0], &curve.control_pts[0][1], &curve.control_pts[1][0], &curve.control_pts[1][1],
+		&curve.control_pts[2][0], &curve.control_pts[2][1], &curve.control_pts[3][0], &curve.control_pts[3][1]) == 8){
+		parsed.push_back(curve);
+	}
+	double text_ms = elapsed_ms(begin);
+	fclose(input);
+
+	begin = bench_clock::now();
+	CurveFile file;
+	bool opened = open_curve_file(binary_path, file);
+	double open_ms = elapsed_ms(begin);
+	std::vector<CubicBezierCurve> mapped;
+	for (int i = 0; opened && i < file.num_curves; i++){
+		mapped.push_back(get_curve(file, i));
+	}
+	double binary_ms = elapsed_ms(begin);
+	bool same = mapped.size() == parsed.size() && memcmp(mapped.data(), parsed.data(), parsed.size() * sizeof(CubicBezierCurve)) == 0;
+	for (int i = 0; same && i < records.size(); i++){
+		same = memcmp(&file.records[i].box, &records[i].box, sizeof(AABB)) == 0;
+	}
+
+	// Box query on the mapping in place, from a fresh open so that no page was touched by the gather above
+	close_curve_file(file);
+	begin = bench_clock::now();
+	opened = open_curve_file(binary_path, file);
+	AABB query = records.empty() ? AABB() : records[0].box;
+	std::vector<int> hits;
+	if (opened) query_box(file, query, hits);
+	double query_ms = elapsed_ms(begin);
+	int expected = 0;
+	for (auto &record: records){
+		expected += record.box.x[0] <= query.x[1] && query.x[0] <= record.box.x[1] && record.box.y[0] <= query.y[1] && query.y[0] <= record.box.y[1];
+	}
+	same = same && (int)hits.size() == expected;
+	close_curve_file(file);
+	printf("\n%10s | %10s %10s %12s %12s | %10s\n", "curves", "text(ms)", "open(ms)", "mapped(ms)", "query(ms)", "same");
+	printf("%10zu | %10.1f %10.3f %12.1f %12.1f | %10s\n", parsed.size(), text_ms, open_ms, binary_ms, query_ms, same ? "yes" : "no");
+	remove(binary_path);
+
+	// Parsing the same curves in memory as control points and as SVG path data with a subpath per curve
+	std::string points_text, svg_text;
+	char number[256];   /* 8 numbers of at most 15 characters with separators */
+	for (auto &c: parsed){
+		for (int j = 0; j < 4; j++){
+			snprintf(number, sizeof(number), "%.9g %.9g\n", c.control_pts[j][0], c.control_pts[j][1]);
+			points_text += number;
+		}
+		snprintf(number, sizeof(number), "M%.9g,%.9g C%.9g,%.9g %.9g,%.9g %.9g,%.9g ", c.control_pts[0][0], c.control_pts[0][1],
+			c.control_pts[1][0], c.control_pts[1][1], c.control_pts[2][0], c.control_pts[2][1], c.control_pts[3][0], c.control_pts[3][1]);
+		svg_text += number;
+	}
+
+	printf("\n%10s | %10s %10s %10s | %10s\n", "format", "input(MB)", "time(ms)", "MB/s", "curves");
+	std::vector<CubicBezierCurve> imported;
+	imported.reserve(parsed.size());
+	begin = bench_clock::now();
+	bool valid = parse_points(points_text.data(), points_text.data() + points_text.size(), imported);
+	ms = elapsed_ms(begin);
+	printf("%10s | %10.1f %10.1f %10.1f | %10zu%s\n", "points", points_text.size() / 1048576.0, ms, points_text.size() / 1048576.0 / (ms / 1000.0),
+		imported.size(), valid && imported.size() == parsed.size() &&
+		memcmp(imported.data(), parsed.data(), parsed.size() * sizeof(CubicBezierCurve)) == 0 ? "" : " (invalid)");
+
+	imported.clear();
+	begin = bench_clock::now();
+	valid = parse_svg_path(svg_text.data(), svg_text.data() + svg_text.size(), imported);
+	ms = elapsed_ms(begin);
+	printf("%10s | %10.1f %10.1f %10.1f | %10zu%s\n", "svg", svg_text.size() / 1048576.0, ms, svg_text.size() / 1048576.0 / (ms / 1000.0),
+		imported.size(), valid && imported.size() == parsed.size() &&
+		memcmp(imported.data(), parsed.data(), parsed.size() * sizeof(CubicBezierCurve)) == 0 ? "" : " (invalid)");
+
+	remove(input_path);
+	remove(output_path);
+	return 0;
+}
@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <chrono>
+#include "circle_tree.h"
+#include "hierarchy_file.h"
+#include "corpus.h"
+
+#define NUM_PAIRS 200
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_us(bench_clock::time_point begin){
+	return std::chrono::duration<double, std::micro>(bench_clock::now() - begin).count();
+}
+
+int main(int argc, char *argv[])
+{
+	std::mt19937 gen(CORPUS_SEED);
+	std::vector<curve_pair> corpus(NUM_PAIRS);
+	for (auto &p: corpus){
+		random_curve(gen, p.first);
+		random_curve(gen, p.second);
+	}
+
+	printf("%5s %6s | %12s %12s | %12s %12s | %12s %12s | %10s\n", "power", "tree",
+		"build(us)", "mindist(us)", "inter(us)", "inter leaves", "mean dist", "mean error", "max diff");
+	for (int power = 2; power <= 8; power += 2){
+		std::vector<REAL> aabb_dist(NUM_PAIRS);
+		double build_us = 0.0, dist_us = 0.0, inter_us = 0.0, mean_dist = 0.0, mean_error = 0.0;
+		long leaves = 0;
+
+		for (int i = 0; i < NUM_PAIRS; i++){
+			auto root1 = std::make_shared<Hierarchy>();
+			auto root2 = std::make_shared<Hierarchy>();
+			root1->curve = corpus[i].first;
+			root2->curve = corpus[i].second;
+
+			auto begin = bench_clock::now();
+			build_hierarchy(root1, power);
+			build_hierarchy(root2, power);
+			build_us += elapsed_us(begin);
+
+			MinDistanceResult result;
+			begin = bench_clock::now();
+			aabb_dist[i] = minimum_distance(root1, root2, result);
+			dist_us += elapsed_us(begin);
+			mean_dist += aabb_dist[i];
+			mean_error += (result.upper_bound - result.lower_bound) / 2.0;
+
+			std::vector<curve_pair> output;
+			begin = bench_clock::now();
+			intersection(root1, root2, output);
+			inter_us += elapsed_us(begin);
+			leaves += output.size();
+		}
+		printf("%5d %6s | %12.2f %12.2f | %12.2f %12.2f | %12.4f %12.4f | %10s\n", power, "aabb",
+			build_us / NUM_PAIRS, dist_us / NUM_PAIRS, inter_us / NUM_PAIRS, (double)leaves / NUM_PAIRS,
+			mean_dist / NUM_PAIRS, mean_error / NUM_PAIRS, "-");
+
+		build_us = dist_us = inter_us = mean_dist = mean_error = 0.0;
+		leaves = 0;
+		REAL max_diff = 0.0;
+		for (int i = 0; i < NUM_PAIRS; i++){
+			auto root1 = std::make_shared<CircleHierarchy>();
+			auto root2 = std::make_shared<CircleHierarchy>();
+			root1->curve = corpus[i].first;
+			root2->curve = corpus[i].second;
+
+			auto begin = bench_clock::now();
+			build_hierarchy(root1, power);
+			build_hierarchy(root2, power);
+			build_us += elapsed_us(begin);
+
+			MinDistanceResult result;
+			begin = bench_clock::now();
+			REAL dist = minimum_distance(root1, root2, result);
+			dist_us += elapsed_us(begin);
+			mean_dist += dist;
+			mean_error += (result.upper_bound - result.lower_bound) / 2.0;
+			max_diff = std::max(max_diff, std::abs(dist - aabb_dist[i]));
+
+			std::vector<curve_pair> output;
+			begin = bench_clock::now();
+			intersection(root1, root2, output);
+			inter_us += elapsed_us(begin);
+			leaves += output.size();
+		}
+		printf("%5d %6s | %12.2f %12.2f | %12.2f %12.2f | %12.4f %12.4f | %10.4f\n", power, "circle",
+			build_us / NUM_PAIRS, dist_us / NUM_PAIRS, inter_us / NUM_PAIRS, (double)leaves / NUM_PAIRS,
+			mean_dist / NUM_PAIRS, mean_error / NUM_PAIRS, max_diff);
+	}
+
+	// Self intersection of every curve of the corpus, pre-check is the share of curves skipped before the tree is visited
+	printf("\n%5s | %12s %12s %12s\n", "power", "self(us)", "loops", "pre-check");
+	for (int power = 2; power <= 8; power += 2){
+		double self_us = 0.0;
+		long loops = 0, skipped = 0;
+		for (int i = 0; i < NUM_PAIRS; i++){
+			auto root = std::make_shared<Hierarchy>();
+			root->curve = corpus[i].first;
+			build_hierarchy(root, power);
+
+			std::vector<SelfIntersection> output;
+			auto begin = bench_clock::now();
+			self_intersection(root, output);
+			self_us += elapsed_us(begin);
+			loops += output.size();
+			skipped += !can_self_intersect(root->curve);
+		}
+		printf("%5d | %12.2f %12ld %11.1f%%\n", power, self_us / NUM_PAIRS, loops, 100.0 * skipped / NUM_PAIRS);
+	}
+
+	// Building the hierarchy, on all hardware threads from leaves of the split level, and reloading it from a
+	// serialized blob, reloaded tree must serialize to the same blob
+	printf("\n%5s | %12s %12s %12s %12s | %10s\n", "power", "build(us)", "threads(us)", "load(us)", "blob(KB)", "same");
+	for (int power = 4; power <= 12; power += 2){
+		double build_us = 0.0, thread_us = 0.0, load_us = 0.0;
+		size_t blob_size = 0;
+		bool same = true;
+		const int num_trees = std::max(1, NUM_PAIRS >> std::max(0, power - 6));
+		for (int i = 0; i < num_trees; i++){
+			auto root1 = std::make_shared<Hierarchy>();
+			root1->curve = corpus[i].first;
+			auto begin = bench_clock::now();
+			build_hierarchy(root1, power);
+			build_us += elapsed_us(begin);
+
+			auto root2 = std::make_shared<Hierarchy>();
+			root2->curve = corpus[i].first;
+			begin = bench_clock::now();
+			build_hierarchy(root2, power, 0);
+			thread_us += elapsed_us(begin);
+
+			std::vector<char> blob;
+			serialize_hierarchy(root1, power, blob);
+			blob_size += blob.size();
+			auto loaded = std::make_shared<Hierarchy>();
+			loaded->curve = corpus[i].first;
+			begin = bench_clock::now();
+			same = deserialize_hierarchy(blob.data(), blob.size(), loaded, power) && same;
+			load_us += elapsed_us(begin);
+
+			std::vector<char> reloaded;
+			serialize_hierarchy(loaded, power, reloaded);
+			same = same && reloaded == blob;
+		}
+		printf("%5d | %12.2f %12.2f %12.2f %12.1f | %10s\n", power, build_us / num_trees, thread_us / num_trees, load_us / num_trees,
+			blob_size / 1024.0 / num_trees, same ? "yes" : "no");
+	}
+
+	return 0;
+}
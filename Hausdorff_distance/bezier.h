@@ -0,0 +1,393 @@
+#ifndef _BEZIER_H_
+#define _BEZIER_H_
+
+#include <queue>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "aabb.h"
+#include "hierarchy.h"
+
+// Bezier curve of degree N in D dimensions with coordinates of type T. Loop bounds are compile time constants,
+// each instantiation is unrolled by the compiler. Bezier<3, REAL> has the layout of CubicBezierCurve
+template <int N, typename T = REAL, int D = 2>
+class Bezier {
+public:
+	T control_pts[N + 1][D];
+};
+
+constexpr int binomial(int n, int k){
+	int value = 1;
+	for (int i = 1; i <= k; i++) value = value * (n - k + i) / i;
+	return value;
+}
+
+static_assert(binomial(5, 2) == 10, "binomial coefficient");
+
+// de Casteljau evaluation
+template <int N, typename T, int D>
+constexpr void evaluate(const Bezier<N, T, D> *curve, const T t, T value[D]){
+	T pts[N + 1][D] = {};
+#pragma GCC unroll 16
+	for (int i = 0; i <= N; i++){
+		for (int k = 0; k < D; k++) pts[i][k] = curve->control_pts[i][k];
+	}
+#pragma GCC unroll 16
+	for (int r = 1; r <= N; r++){
+#pragma GCC unroll 16
+		for (int i = 0; i <= N - r; i++){
+			for (int k = 0; k < D; k++) pts[i][k] = (1 - t) * pts[i][k] + t * pts[i + 1][k];
+		}
+	}
+	for (int k = 0; k < D; k++) value[k] = pts[0][k];
+}
+
+// Sum of control points weighted by the Bernstein polynomials, fewer operations than de Casteljau but less stable
+template <int N, typename T, int D>
+constexpr void evaluate_bernstein(const Bezier<N, T, D> *curve, const T t, T value[D]){
+	T t_pow[N + 1] = {}, t_inv_pow[N + 1] = {};
+	t_pow[0] = t_inv_pow[0] = 1;
+#pragma GCC unroll 16
+	for (int i = 1; i <= N; i++){
+		t_pow[i] = t_pow[i - 1] * t;
+		t_inv_pow[i] = t_inv_pow[i - 1] * (1 - t);
+	}
+	for (int k = 0; k < D; k++) value[k] = 0;
+#pragma GCC unroll 16
+	for (int i = 0; i <= N; i++){
+		const T b = binomial(N, i) * t_pow[i] * t_inv_pow[N - i];
+		for (int k = 0; k < D; k++) value[k] += b * curve->control_pts[i][k];
+	}
+}
+
+// Hodograph, a curve of degree N - 1
+template <int N, typename T, int D>
+constexpr void derivative(const Bezier<N, T, D> *curve, Bezier<N - 1, T, D> *output){
+	static_assert(N >= 1, "derivative of a point");
+#pragma GCC unroll 16
+	for (int i = 0; i < N; i++){
+		for (int k = 0; k < D; k++) output->control_pts[i][k] = N * (curve->control_pts[i + 1][k] - curve->control_pts[i][k]);
+	}
+}
+
+template <int N, typename T, int D>
+constexpr void evaluate_derivative(const Bezier<N, T, D> *curve, const T t, T value[D]){
+	Bezier<N - 1, T, D> hodograph = {};
+	derivative(curve, &hodograph);
+	evaluate(&hodograph, t, value);
+}
+
+// Exact degree elevation, the curve is unchanged
+template <int N, typename T, int D>
+constexpr void elevate(const Bezier<N, T, D> *curve, Bezier<N + 1, T, D> *output){
+	for (int k = 0; k < D; k++) output->control_pts[0][k] = curve->control_pts[0][k];
+#pragma GCC unroll 16
+	for (int i = 1; i <= N; i++){
+		const T a = (T)i / (N + 1);
+		for (int k = 0; k < D; k++) output->control_pts[i][k] = a * curve->control_pts[i - 1][k] + (1 - a) * curve->control_pts[i][k];
+	}
+	for (int k = 0; k < D; k++) output->control_pts[N + 1][k] = curve->control_pts[N][k];
+}
+
+// Splits at t with de Casteljau, out1 is the part over [0, t] and out2 over [t, 1]
+template <int N, typename T, int D>
+constexpr void subdivide(const Bezier<N, T, D> *curve, const T t, Bezier<N, T, D> *out1, Bezier<N, T, D> *out2){
+	T pts[N + 1][D] = {};
+#pragma GCC unroll 16
+	for (int i = 0; i <= N; i++){
+		for (int k = 0; k < D; k++) pts[i][k] = curve->control_pts[i][k];
+	}
+	for (int k = 0; k < D; k++){
+		out1->control_pts[0][k] = pts[0][k];
+		out2->control_pts[N][k] = pts[N][k];
+	}
+#pragma GCC unroll 16
+	for (int r = 1; r <= N; r++){
+#pragma GCC unroll 16
+		for (int i = 0; i <= N - r; i++){
+			for (int k = 0; k < D; k++) pts[i][k] = (1 - t) * pts[i][k] + t * pts[i + 1][k];
+		}
+		for (int k = 0; k < D; k++){
+			out1->control_pts[r][k] = pts[0][k];
+			out2->control_pts[N - r][k] = pts[N - r][k];
+		}
+	}
+}
+
+// Box of the control points, which contains the curve
+template <int N, typename T>
+AABB get_curve_aabb(const Bezier<N, T> *curve){
+	AABB box;
+	box.x[0] = box.x[1] = curve->control_pts[0][0];
+	box.y[0] = box.y[1] = curve->control_pts[0][1];
+#pragma GCC unroll 16
+	for (int i = 1; i <= N; i++){
+		box.x[0] = std::min(box.x[0], (REAL)curve->control_pts[i][0]);
+		box.x[1] = std::max(box.x[1], (REAL)curve->control_pts[i][0]);
+		box.y[0] = std::min(box.y[0], (REAL)curve->control_pts[i][1]);
+		box.y[1] = std::max(box.y[1], (REAL)curve->control_pts[i][1]);
+	}
+	return box;
+}
+
+template <typename T>
+void from_cubic(const CubicBezierCurve *curve, Bezier<3, T> *output){
+	for (int i = 0; i < 4; i++){
+		output->control_pts[i][0] = curve->control_pts[i][0];
+		output->control_pts[i][1] = curve->control_pts[i][1];
+	}
+}
+
+// Elevates curves of degree up to 3 to a cubic, to build the biarc hierarchy of hierarchy.h over them
+template <int N, typename T>
+void to_cubic(const Bezier<N, T> *curve, CubicBezierCurve *output){
+	static_assert(N >= 1 && N <= 3, "a cubic can not represent curves of degree above 3");
+	if constexpr (N == 3){
+		for (int i = 0; i < 4; i++) SET_PT2(output->control_pts[i], curve->control_pts[i][0], curve->control_pts[i][1]);
+	}
+	else {
+		Bezier<N + 1, T> elevated = {};
+		elevate(curve, &elevated);
+		to_cubic(&elevated, output);
+	}
+}
+
+template <int N, typename T>
+void build_hierarchy(std::shared_ptr<Hierarchy> h, const Bezier<N, T> &curve, int power){
+	to_cubic(&curve, &h->curve);
+	build_hierarchy(h, power);
+}
+
+// Distance from p to the box of the control points in the frame of the chord, the box is as thin as the
+// deviation of the curve from its chord and the bound tightens quadratically with subdivision
+template <int N, typename T>
+T distance_lower_bound(const T p[2], const Bezier<N, T> &c){
+	T u[2] = { c.control_pts[N][0] - c.control_pts[0][0], c.control_pts[N][1] - c.control_pts[0][1] };
+	T length = std::sqrt(u[0] * u[0] + u[1] * u[1]);
+	if (length == 0){
+		// Closed curve, axis aligned frame
+		u[0] = 1;
+		u[1] = 0;
+	}
+	else {
+		u[0] /= length;
+		u[1] /= length;
+	}
+	T lower[2], upper[2];
+	lower[0] = upper[0] = lower[1] = upper[1] = 0;
+#pragma GCC unroll 16
+	for (int i = 1; i <= N; i++){
+		const T d[2] = { c.control_pts[i][0] - c.control_pts[0][0], c.control_pts[i][1] - c.control_pts[0][1] };
+		const T along = d[0] * u[0] + d[1] * u[1], across = d[1] * u[0] - d[0] * u[1];
+		lower[0] = std::min(lower[0], along);
+		upper[0] = std::max(upper[0], along);
+		lower[1] = std::min(lower[1], across);
+		upper[1] = std::max(upper[1], across);
+	}
+	const T d[2] = { p[0] - c.control_pts[0][0], p[1] - c.control_pts[0][1] };
+	const T along = d[0] * u[0] + d[1] * u[1], across = d[1] * u[0] - d[0] * u[1];
+	const T dx = std::max((T)0, std::max(lower[0] - along, along - upper[0]));
+	const T dy = std::max((T)0, std::max(lower[1] - across, across - upper[1]));
+	return std::sqrt(dx * dx + dy * dy);
+}
+
+template <typename T, int D>
+inline T point_distance_nd(const T p1[D], const T p2[D]){
+	T sum = 0;
+	for (int k = 0; k < D; k++) sum += (p1[k] - p2[k]) * (p1[k] - p2[k]);
+	return std::sqrt(sum);
+}
+
+// Distance from p to the cylinder around the chord through the control points, the general dimension form of
+// the bound above, the radius of the cylinder shrinks quadratically with subdivision as well
+template <int N, typename T, int D>
+T distance_lower_bound(const T p[D], const Bezier<N, T, D> &c){
+	T u[D];
+	T length_sq = 0;
+	for (int k = 0; k < D; k++){
+		u[k] = c.control_pts[N][k] - c.control_pts[0][k];
+		length_sq += u[k] * u[k];
+	}
+	if (length_sq == 0){
+		// Closed curve, bounding ball around the first control point
+		T radius = 0;
+		for (int i = 1; i <= N; i++) radius = std::max(radius, point_distance_nd<T, D>(c.control_pts[i], c.control_pts[0]));
+		return std::max((T)0, point_distance_nd<T, D>(p, c.control_pts[0]) - radius);
+	}
+	const T length = std::sqrt(length_sq);
+	for (int k = 0; k < D; k++) u[k] /= length;
+
+	// Position along the chord and distance across it, relative to the first control point
+	auto split = [&](const T q[D], T &along, T &across){
+		along = 0;
+		for (int k = 0; k < D; k++) along += (q[k] - c.control_pts[0][k]) * u[k];
+		T across_sq = 0;
+		for (int k = 0; k < D; k++){
+			const T d = q[k] - c.control_pts[0][k] - along * u[k];
+			across_sq += d * d;
+		}
+		across = std::sqrt(across_sq);
+	};
+	T lower = 0, upper = 0, radius = 0;
+#pragma GCC unroll 16
+	for (int i = 1; i <= N; i++){
+		T along, across;
+		split(c.control_pts[i], along, across);
+		lower = std::min(lower, along);
+		upper = std::max(upper, along);
+		radius = std::max(radius, across);
+	}
+	T along, across;
+	split(p, along, across);
+	const T dx = std::max((T)0, std::max(lower - along, along - upper));
+	const T dy = std::max((T)0, across - radius);
+	return std::sqrt(dx * dx + dy * dy);
+}
+
+// Best first search over halved parameter intervals as projection in hausdorff.h, distance_lower_bound gives the
+// lower bound of an interval and its midpoint the upper bound. Returns the parameter of the closest point
+template <int N, typename T, int D>
+T projection(const T p[D], const Bezier<N, T, D> &c){
+	class Node {
+	public:
+		T bound;
+		T t[2];
+		Bezier<N, T, D> curve;
+		bool operator>(const Node &other) const { return bound > other.bound; }
+	};
+	std::priority_queue<Node, std::vector<Node>, std::greater<Node>> q;
+
+	auto point_distance = [&](const T q[D]){ return point_distance_nd<T, D>(p, q); };
+	T globalt = 0.0;
+	T upper_bound = point_distance(c.control_pts[0]);
+	if (point_distance(c.control_pts[N]) < upper_bound){
+		upper_bound = point_distance(c.control_pts[N]);
+		globalt = 1.0;
+	}
+
+	q.push(Node{ distance_lower_bound(p, c), { 0.0, 1.0 }, c });
+	while (!q.empty()){
+		const Node node = q.top();
+		q.pop();
+		if (node.bound > upper_bound) break;
+		// Gap is relative to the distance as in the cubic projection
+		if (upper_bound - node.bound < PRECISION * std::max((T)1.0, upper_bound)) break;
+
+		const T middle_t = (node.t[0] + node.t[1]) / 2;
+		if (middle_t <= node.t[0] || middle_t >= node.t[1]) continue;
+		Node children[2];
+		subdivide(&node.curve, (T)0.5, &children[0].curve, &children[1].curve);
+		children[0].t[0] = node.t[0];
+		children[0].t[1] = children[1].t[0] = middle_t;
+		children[1].t[1] = node.t[1];
+
+		// Split point is the midpoint of the interval
+		const T split_distance = point_distance(children[1].curve.control_pts[0]);
+		if (split_distance < upper_bound){
+			upper_bound = split_distance;
+			globalt = middle_t;
+		}
+		for (auto &child: children){
+			child.bound = std::max(node.bound, distance_lower_bound(p, child.curve));
+			if (child.bound < upper_bound) q.push(child);
+		}
+	}
+	return globalt;
+}
+
+template <typename T, int D = 2>
+class BezierIntersection {
+public:
+	T t1;
+	T t2;
+	T point[D];
+};
+
+// Newton iteration on curve1(t1) = curve2(t2) as refine_intersection in hierarchy.h
+template <int N, int M, typename T>
+bool refine_intersection(const Bezier<N, T> &curve1, const Bezier<M, T> &curve2, T &t1, T &t2, T point[2]){
+	for (int i = 0; i < NEWTON_ITERATIONS; i++){
+		T p1[2], p2[2], d1[2], d2[2];
+		evaluate(&curve1, t1, p1);
+		evaluate(&curve2, t2, p2);
+		const T f[2] = { p1[0] - p2[0], p1[1] - p2[1] };
+
+		const T tolerance = EPS * std::max((T)1.0, std::max(std::abs(p1[0]), std::abs(p1[1])));
+		if (std::sqrt(f[0] * f[0] + f[1] * f[1]) <= tolerance){
+			point[0] = p1[0];
+			point[1] = p1[1];
+			return true;
+		}
+
+		evaluate_derivative(&curve1, t1, d1);
+		evaluate_derivative(&curve2, t2, d2);
+		const T det = -d1[0] * d2[1] + d2[0] * d1[1];
+		if (std::abs(det) <= EPS * std::sqrt((d1[0] * d1[0] + d1[1] * d1[1]) * (d2[0] * d2[0] + d2[1] * d2[1]))) return false;
+		t1 = std::max((T)0.0, std::min((T)1.0, t1 + (f[0] * d2[1] - d2[0] * f[1]) / det));
+		t2 = std::max((T)0.0, std::min((T)1.0, t2 + (f[0] * d1[1] - d1[0] * f[1]) / det));
+	}
+	return false;
+}
+
+// Subdivides both curves while their control point boxes overlap, down to max_depth halvings of the larger
+// box, and refines each remaining pair with Newton iteration. Crossings closer than 1e-3 in both parameters
+// are reported once, output is sorted by t1
+template <int N, int M, typename T>
+void intersection(const Bezier<N, T> &curve1, const Bezier<M, T> &curve2, std::vector<BezierIntersection<T>> &output, int max_depth = 16){
+	class Pair {
+	public:
+		Bezier<N, T> curve1;
+		Bezier<M, T> curve2;
+		T t1[2];
+		T t2[2];
+		int depth;
+	};
+	std::vector<Pair> stack;
+	stack.push_back(Pair{ curve1, curve2, { 0.0, 1.0 }, { 0.0, 1.0 }, 0 });
+	std::vector<BezierIntersection<T>> found;
+	while (!stack.empty()){
+		Pair pair = stack.back();
+		stack.pop_back();
+		const AABB box1 = get_curve_aabb(&pair.curve1), box2 = get_curve_aabb(&pair.curve2);
+		if (box1.x[0] > box2.x[1] || box2.x[0] > box1.x[1] || box1.y[0] > box2.y[1] || box2.y[0] > box1.y[1]) continue;
+
+		if (pair.depth == max_depth){
+			BezierIntersection<T> inter;
+			inter.t1 = (pair.t1[0] + pair.t1[1]) / 2;
+			inter.t2 = (pair.t2[0] + pair.t2[1]) / 2;
+			if (refine_intersection(curve1, curve2, inter.t1, inter.t2, inter.point)) found.push_back(inter);
+			continue;
+		}
+
+		// Box with the longer side is halved
+		Pair children[2] = { pair, pair };
+		if (diameter(box1) >= diameter(box2)){
+			const T middle = (pair.t1[0] + pair.t1[1]) / 2;
+			subdivide(&pair.curve1, (T)0.5, &children[0].curve1, &children[1].curve1);
+			children[0].t1[1] = children[1].t1[0] = middle;
+		}
+		else {
+			const T middle = (pair.t2[0] + pair.t2[1]) / 2;
+			subdivide(&pair.curve2, (T)0.5, &children[0].curve2, &children[1].curve2);
+			children[0].t2[1] = children[1].t2[0] = middle;
+		}
+		for (auto &child: children){
+			child.depth = pair.depth + 1;
+			stack.push_back(child);
+		}
+	}
+
+	std::sort(found.begin(), found.end(), [](const BezierIntersection<T> &a, const BezierIntersection<T> &b){ return a.t1 < b.t1; });
+	for (auto &inter: found){
+		bool duplicate = false;
+		for (auto &other: output){
+			if (std::abs(other.t1 - inter.t1) < 1e-3 && std::abs(other.t2 - inter.t2) < 1e-3){
+				duplicate = true;
+				break;
+			}
+		}
+		if (!duplicate) output.push_back(inter);
+	}
+}
+
+#endif /* _BEZIER_H_ */
@@ -0,0 +1,470 @@
+#ifndef _BEZIER_TREE_H_
+#define _BEZIER_TREE_H_
+
+#include <memory>
+#include <limits>
+#include "bezier.h"
+#include "search_stats.h"
+
+// Axis aligned box in D dimensions
+template <typename T, int D>
+class BoundingBox {
+public:
+	T lower[D];
+	T upper[D];
+};
+
+// Box of the control points, which contains the curve
+template <int N, typename T, int D>
+BoundingBox<T, D> get_curve_box(const Bezier<N, T, D> *curve){
+	BoundingBox<T, D> box;
+	for (int k = 0; k < D; k++) box.lower[k] = box.upper[k] = curve->control_pts[0][k];
+#pragma GCC unroll 16
+	for (int i = 1; i <= N; i++){
+		for (int k = 0; k < D; k++){
+			box.lower[k] = std::min(box.lower[k], curve->control_pts[i][k]);
+			box.upper[k] = std::max(box.upper[k], curve->control_pts[i][k]);
+		}
+	}
+	return box;
+}
+
+template <typename T, int D>
+T distance(const BoundingBox<T, D> &box1, const BoundingBox<T, D> &box2){
+	T sum = 0;
+	for (int k = 0; k < D; k++){
+		const T gap = std::max((T)0, std::max(box1.lower[k] - box2.upper[k], box2.lower[k] - box1.upper[k]));
+		sum += gap * gap;
+	}
+	return std::sqrt(sum);
+}
+
+template <typename T, int D>
+T diameter(const BoundingBox<T, D> &box){
+	T sum = 0;
+	for (int k = 0; k < D; k++) sum += (box.upper[k] - box.lower[k]) * (box.upper[k] - box.lower[k]);
+	return std::sqrt(sum);
+}
+
+// Distance from p to the segment from begin to end, the parameter of the closest point is set to s
+template <typename T, int D>
+T point_segment_distance(const T p[D], const T begin[D], const T end[D], T &s){
+	T dir_sq = 0, dot = 0;
+	for (int k = 0; k < D; k++){
+		dir_sq += (end[k] - begin[k]) * (end[k] - begin[k]);
+		dot += (p[k] - begin[k]) * (end[k] - begin[k]);
+	}
+	s = dir_sq > 0 ? std::max((T)0, std::min((T)1, dot / dir_sq)) : 0;
+	T sum = 0;
+	for (int k = 0; k < D; k++){
+		const T d = p[k] - (begin[k] + s * (end[k] - begin[k]));
+		sum += d * d;
+	}
+	return std::sqrt(sum);
+}
+
+// Closest points of segments p0 p1 and q0 q1 with the clamped solution of the 2 x 2 normal equations, the
+// parameters of the closest points are set to s and t
+template <typename T, int D>
+T segment_distance(const T p0[D], const T p1[D], const T q0[D], const T q1[D], T &s, T &t){
+	T d1[D], d2[D], r[D];
+	T a = 0, e = 0, b = 0, c = 0, f = 0;
+	for (int k = 0; k < D; k++){
+		d1[k] = p1[k] - p0[k];
+		d2[k] = q1[k] - q0[k];
+		r[k] = p0[k] - q0[k];
+		a += d1[k] * d1[k];
+		e += d2[k] * d2[k];
+		b += d1[k] * d2[k];
+		c += d1[k] * r[k];
+		f += d2[k] * r[k];
+	}
+	if (a <= 0 && e <= 0){
+		s = t = 0;
+		return point_distance_nd<T, D>(p0, q0);
+	}
+	if (a <= 0){
+		s = 0;
+		return point_segment_distance<T, D>(p0, q0, q1, t);
+	}
+	if (e <= 0){
+		t = 0;
+		return point_segment_distance<T, D>(q0, p0, p1, s);
+	}
+	const T denom = a * e - b * b;
+	s = denom > 0 ? std::max((T)0, std::min((T)1, (b * f - c * e) / denom)) : 0;
+	t = (b * s + f) / e;
+	// Clamp t and recompute s for the clamped t
+	if (t < 0){
+		t = 0;
+		s = std::max((T)0, std::min((T)1, -c / a));
+	}
+	else if (t > 1){
+		t = 1;
+		s = std::max((T)0, std::min((T)1, (b - c) / a));
+	}
+	T sum = 0;
+	for (int k = 0; k < D; k++){
+		const T d = r[k] + s * d1[k] - t * d2[k];
+		sum += d * d;
+	}
+	return std::sqrt(sum);
+}
+
+// Node of a hierarchy over a Bezier curve of any degree and dimension. Biarcs are planar, so a leaf is the
+// chord of its curve and error is the largest distance of its control points from the chord, which bounds the
+// distance of the curve from the chord. Boxes are control point boxes, which contain the curve without inflation
+template <int N, typename T = REAL, int D = 2>
+class BezierTree {
+public:
+	Bezier<N, T, D> curve;
+	BoundingBox<T, D> box;
+	T t[2] = { 0.0, 1.0 };   /* parameter interval of the node on the root curve */
+	std::shared_ptr<BezierTree> left = nullptr;
+	std::shared_ptr<BezierTree> right = nullptr;
+	T error = 0.0;
+};
+
+// Splits the curve of the node power times at parameter middles, curve of the root must be set
+template <int N, typename T, int D>
+void build_hierarchy(std::shared_ptr<BezierTree<N, T, D>> h, int power){
+	h->box = get_curve_box(&h->curve);
+	if (power == 0){
+		T s;
+		h->error = 0;
+		for (int i = 1; i < N; i++){
+			h->error = std::max(h->error, point_segment_distance<T, D>(h->curve.control_pts[i], h->curve.control_pts[0], h->curve.control_pts[N], s));
+		}
+		return;
+	}
+	h->left = std::make_shared<BezierTree<N, T, D>>();
+	h->right = std::make_shared<BezierTree<N, T, D>>();
+	subdivide(&h->curve, (T)0.5, &h->left->curve, &h->right->curve);
+	const T t_middle = (h->t[0] + h->t[1]) / 2;
+	h->left->t[0] = h->t[0];
+	h->left->t[1] = h->right->t[0] = t_middle;
+	h->right->t[1] = h->t[1];
+	build_hierarchy(h->left, power - 1);
+	build_hierarchy(h->right, power - 1);
+}
+
+template <typename T, int D>
+class BezierDistanceResult {
+public:
+	T lower_bound;
+	T upper_bound;
+	T t1;
+	T t2;
+	T point1[D];
+	T point2[D];
+	bool budget_exhausted;   /* query was stopped by its budget before convergence */
+};
+
+// Best first search over pairs of nodes as minimum_distance in hierarchy.h. Box distances are lower bounds, the
+// curves at the parameters of the closest chord points give upper bounds, and the chord distance less the leaf
+// errors is the lower bound of a leaf pair. Returns the middle of [lower_bound, upper_bound]
+template <int N, typename T, int D>
+T minimum_distance(std::shared_ptr<BezierTree<N, T, D>> tree1, std::shared_ptr<BezierTree<N, T, D>> tree2,
+	BezierDistanceResult<T, D> &result, SearchStats *stats = nullptr){
+	typedef std::shared_ptr<BezierTree<N, T, D>> Node;
+	class Entry {
+	public:
+		T bound;
+		long order;   /* insertion order breaks ties, so that the search does not depend on addresses */
+		Node node1;
+		Node node2;
+		bool operator>(const Entry &other) const { return bound > other.bound || (bound == other.bound && order > other.order); }
+	};
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> q;
+	long order = 0;
+	if (stats) stats->reset();
+
+	// Upper bound from the points of both nodes at the given node parameters
+	T upper_bound = std::numeric_limits<T>::max();
+	auto update_upper_bound = [&](const Node &node1, const Node &node2, T s, T t){
+		T p1[D], p2[D];
+		evaluate(&node1->curve, s, p1);
+		evaluate(&node2->curve, t, p2);
+		const T d = point_distance_nd<T, D>(p1, p2);
+		if (d < upper_bound){
+			upper_bound = d;
+			result.t1 = node1->t[0] + s * (node1->t[1] - node1->t[0]);
+			result.t2 = node2->t[0] + t * (node2->t[1] - node2->t[0]);
+			for (int k = 0; k < D; k++){
+				result.point1[k] = p1[k];
+				result.point2[k] = p2[k];
+			}
+			if (stats) stats->update_upper_bound();
+		}
+	};
+	for (int i = 0; i <= 2; i++){
+		for (int j = 0; j <= 2; j++) update_upper_bound(tree1, tree2, i / (T)2, j / (T)2);
+	}
+
+	T lower_bound = distance(tree1->box, tree2->box);
+	T leaf_lower_bound = std::numeric_limits<T>::max();
+	q.push(Entry{ lower_bound, order++, tree1, tree2 });
+	if (stats) stats->push(q.size());
+	while (!q.empty()){
+		const Entry entry = q.top();
+		if (entry.bound > upper_bound){
+			// Remaining pairs are farther than the upper bound, only resolved leaf pairs can be closer
+			lower_bound = std::min(upper_bound, std::min(entry.bound, leaf_lower_bound));
+			break;
+		}
+		lower_bound = entry.bound;
+		q.pop();
+		const Node &node1 = entry.node1, &node2 = entry.node2;
+		if (stats) stats->pop(lower_bound, upper_bound, q.size(), std::max(diameter(node1->box), diameter(node2->box)));
+
+		if (node1->left == nullptr && node2->left == nullptr){
+			if (stats) stats->leaf_tests++;
+			T s, t;
+			const T chord_distance = segment_distance<T, D>(node1->curve.control_pts[0], node1->curve.control_pts[N],
+				node2->curve.control_pts[0], node2->curve.control_pts[N], s, t);
+			leaf_lower_bound = std::min(leaf_lower_bound, std::max((T)0, chord_distance - node1->error - node2->error));
+			update_upper_bound(node1, node2, s, t);
+			continue;
+		}
+		update_upper_bound(node1, node2, (T)0.5, (T)0.5);
+
+		// Node with larger box is divided
+		const bool split1 = node2->left == nullptr || (node1->left != nullptr && diameter(node1->box) > diameter(node2->box));
+		const Node children[2][2] = {
+			{ split1 ? node1->left : node1, split1 ? node2 : node2->left },
+			{ split1 ? node1->right : node1, split1 ? node2 : node2->right },
+		};
+		for (auto &child: children){
+			const T child_bound = std::max(entry.bound, distance(child[0]->box, child[1]->box));
+			if (child_bound < upper_bound){
+				q.push(Entry{ child_bound, order++, child[0], child[1] });
+				if (stats) stats->push(q.size());
+			}
+			else if (stats) stats->pruned++;
+		}
+	}
+	if (q.empty()) lower_bound = std::min(upper_bound, leaf_lower_bound);
+	if (stats) stats->final_gap = upper_bound - lower_bound;
+
+	result.budget_exhausted = false;
+	result.lower_bound = lower_bound;
+	result.upper_bound = upper_bound;
+	return (upper_bound + lower_bound) / 2;
+}
+
+// Gauss-Newton iteration on |curve1(t1) - curve2(t2)|^2, the least squares form of refine_intersection for any
+// dimension. Returns true if the distance falls within tolerance
+template <int N, typename T, int D>
+bool refine_contact(const Bezier<N, T, D> &curve1, const Bezier<N, T, D> &curve2, T &t1, T &t2, T tolerance, T point[D]){
+	for (int i = 0; i < NEWTON_ITERATIONS; i++){
+		T p1[D], p2[D], d1[D], d2[D], f[D];
+		evaluate(&curve1, t1, p1);
+		evaluate(&curve2, t2, p2);
+		T f_sq = 0;
+		for (int k = 0; k < D; k++){
+			f[k] = p1[k] - p2[k];
+			f_sq += f[k] * f[k];
+		}
+		if (std::sqrt(f_sq) <= tolerance){
+			for (int k = 0; k < D; k++) point[k] = p1[k];
+			return true;
+		}
+
+		// [d1, -d2]^T [d1, -d2] (dt1, dt2) = -[d1, -d2]^T f
+		evaluate_derivative(&curve1, t1, d1);
+		evaluate_derivative(&curve2, t2, d2);
+		T a = 0, b = 0, c = 0, g1 = 0, g2 = 0;
+		for (int k = 0; k < D; k++){
+			a += d1[k] * d1[k];
+			b -= d1[k] * d2[k];
+			c += d2[k] * d2[k];
+			g1 += d1[k] * f[k];
+			g2 -= d2[k] * f[k];
+		}
+		const T det = a * c - b * b;
+		if (det <= EPS * a * c) return false;
+		t1 = std::max((T)0.0, std::min((T)1.0, t1 - (c * g1 - b * g2) / det));
+		t2 = std::max((T)0.0, std::min((T)1.0, t2 - (a * g2 - b * g1) / det));
+	}
+	return false;
+}
+
+// Parameters where the curves of both trees come within tolerance, found from the leaf pairs whose boxes are
+// within tolerance and refined on the root curves. In the plane with a tolerance at the resolution of REAL these
+// are the intersections. Contacts closer than 1e-3 in both parameters are reported once, output is sorted by t1
+template <int N, typename T, int D>
+void intersection(std::shared_ptr<BezierTree<N, T, D>> tree1, std::shared_ptr<BezierTree<N, T, D>> tree2, T tolerance,
+	std::vector<BezierIntersection<T, D>> &output){
+	typedef std::shared_ptr<BezierTree<N, T, D>> Node;
+	std::vector<std::pair<Node, Node>> stack, leaves;
+	stack.push_back(std::make_pair(tree1, tree2));
+	while (!stack.empty()){
+		auto pair = stack.back();
+		stack.pop_back();
+		const Node &node1 = pair.first, &node2 = pair.second;
+		if (distance(node1->box, node2->box) > tolerance) continue;
+		if (node1->left != nullptr && (node2->left == nullptr || diameter(node1->box) > diameter(node2->box))){
+			stack.push_back(std::make_pair(node1->left, node2));
+			stack.push_back(std::make_pair(node1->right, node2));
+		}
+		else if (node2->left != nullptr){
+			stack.push_back(std::make_pair(node1, node2->left));
+			stack.push_back(std::make_pair(node1, node2->right));
+		}
+		else leaves.push_back(pair);
+	}
+
+	std::vector<BezierIntersection<T, D>> found;
+	for (auto &pair: leaves){
+		const Node &node1 = pair.first, &node2 = pair.second;
+		T s, t;
+		const T chord_distance = segment_distance<T, D>(node1->curve.control_pts[0], node1->curve.control_pts[N],
+			node2->curve.control_pts[0], node2->curve.control_pts[N], s, t);
+		if (chord_distance > tolerance + node1->error + node2->error) continue;
+
+		BezierIntersection<T, D> contact;
+		contact.t1 = node1->t[0] + s * (node1->t[1] - node1->t[0]);
+		contact.t2 = node2->t[0] + t * (node2->t[1] - node2->t[0]);
+		if (refine_contact(tree1->curve, tree2->curve, contact.t1, contact.t2, tolerance, contact.point)) found.push_back(contact);
+	}
+
+	std::sort(found.begin(), found.end(), [](const BezierIntersection<T, D> &a, const BezierIntersection<T, D> &b){ return a.t1 < b.t1; });
+	for (auto &contact: found){
+		bool duplicate = false;
+		for (auto &other: output){
+			if (std::abs(other.t1 - contact.t1) < 1e-3 && std::abs(other.t2 - contact.t2) < 1e-3){
+				duplicate = true;
+				break;
+			}
+		}
+		if (!duplicate) output.push_back(contact);
+	}
+}
+
+// Largest distance of corresponding control points, in both orders of the second curve as bezier_error_bound
+template <int N, typename T, int D>
+T error_bound(const Bezier<N, T, D> &curve1, const Bezier<N, T, D> &curve2){
+	T bound1 = 0, bound2 = 0;
+	for (int i = 0; i <= N; i++){
+		bound1 = std::max(bound1, point_distance_nd<T, D>(curve1.control_pts[i], curve2.control_pts[i]));
+		bound2 = std::max(bound2, point_distance_nd<T, D>(curve1.control_pts[i], curve2.control_pts[N - i]));
+	}
+	return std::min(bound1, bound2);
+}
+
+// Part of the curve over [t1, t2]
+template <int N, typename T, int D>
+Bezier<N, T, D> subcurve(const Bezier<N, T, D> &c, T t1, T t2){
+	Bezier<N, T, D> seg1, seg2, dummy;
+	subdivide(&c, t1, &dummy, &seg1);
+	if (t1 < 1) subdivide(&seg1, (t2 - t1) / (1 - t1), &seg2, &dummy);
+	else seg2 = seg1;
+	return seg2;
+}
+
+// Branch and bound over parameter intervals of both curves as hausdorff_distance in hausdorff.h. The interval with
+// the largest upper bound is halved, an interval is bounded by the control point distance to the part of the other
+// curve between the projections of its endpoints or by the distance of an endpoint plus the radius of the interval
+// around it, and projections of interval endpoints give the lower bound. Stops at a gap relative to the distance of
+// PRECISION or when the budget is exhausted, returns the middle of [lower_bound, upper_bound]
+template <int N, typename T, int D>
+T hausdorff_distance(const Bezier<N, T, D> &curve1, const Bezier<N, T, D> &curve2, BezierDistanceResult<T, D> &result,
+	SearchStats *stats = nullptr, const SearchBudget *budget = nullptr){
+	class Interval {
+	public:
+		T bound;
+		T t[2];
+		bool second;   /* interval of curve2, projected onto curve1 */
+		bool operator<(const Interval &other) const { return bound < other.bound; }
+	};
+	std::priority_queue<Interval> q;
+	if (stats) stats->reset();
+	auto begin = std::chrono::steady_clock::now();
+	long pops = 0;
+
+	T lower_bound = 0;
+	auto update_lower_bound = [&](const Bezier<N, T, D> &source, const Bezier<N, T, D> &target, T s, bool second, T &t){
+		T p[D], q[D];
+		evaluate(&source, s, p);
+		t = projection(p, target);
+		evaluate(&target, t, q);
+		const T d = point_distance_nd<T, D>(p, q);
+		if (d > lower_bound){
+			lower_bound = d;
+			result.t1 = second ? t : s;
+			result.t2 = second ? s : t;
+			for (int k = 0; k < D; k++){
+				result.point1[k] = second ? q[k] : p[k];
+				result.point2[k] = second ? p[k] : q[k];
+			}
+			if (stats) stats->update_lower_bound();
+		}
+		return d;
+	};
+	T t;
+	update_lower_bound(curve1, curve2, (T)0.5, false, t);
+	update_lower_bound(curve2, curve1, (T)0.5, true, t);
+
+	T upper_bound = error_bound(curve1, curve2);
+	if (stats) stats->update_upper_bound();
+	q.push(Interval{ upper_bound, { 0.0, 1.0 }, false });
+	q.push(Interval{ upper_bound, { 0.0, 1.0 }, true });
+	if (stats){
+		stats->push(1);
+		stats->push(2);
+	}
+
+	result.budget_exhausted = false;
+	while (!q.empty()){
+		const Interval interval = q.top();
+		// Entries pushed before the lower bound rose can be below it, then no interval is farther than it
+		upper_bound = std::max(interval.bound, lower_bound);
+		if (upper_bound - lower_bound <= PRECISION * std::max((T)1.0, upper_bound)) break;
+		if (budget && budget->exhausted(pops, begin)){
+			result.budget_exhausted = true;
+			break;
+		}
+		const T t_middle = (interval.t[0] + interval.t[1]) / 2;
+		// Interval at the resolution of T can not be halved, its bound is final
+		if (t_middle <= interval.t[0] || t_middle >= interval.t[1]) break;
+		q.pop();
+		pops++;
+		if (stats) stats->pop(lower_bound, upper_bound, q.size(), interval.t[1] - interval.t[0]);
+
+		const Bezier<N, T, D> &source = interval.second ? curve2 : curve1;
+		const Bezier<N, T, D> &target = interval.second ? curve1 : curve2;
+		const T ends[3] = { interval.t[0], t_middle, interval.t[1] };
+		T projected[3], distances[3];
+		for (int i = 0; i < 3; i++) distances[i] = update_lower_bound(source, target, ends[i], interval.second, projected[i]);
+		if (stats) stats->leaf_tests += 3;
+
+		for (int i = 0; i < 2; i++){
+			const Bezier<N, T, D> half = subcurve(source, ends[i], ends[i + 1]);
+			const Bezier<N, T, D> other = subcurve(target, std::min(projected[i], projected[i + 1]), std::max(projected[i], projected[i + 1]));
+			// Endpoints projected to different branches of the target give a loose control point bound, the
+			// distance of an endpoint plus the radius of the half around it stays valid and shrinks with the interval
+			T radius[2] = { 0.0, 0.0 };
+			for (int j = 0; j <= N; j++){
+				radius[0] = std::max(radius[0], point_distance_nd<T, D>(half.control_pts[j], half.control_pts[0]));
+				radius[1] = std::max(radius[1], point_distance_nd<T, D>(half.control_pts[j], half.control_pts[N]));
+			}
+			const T ball_bound = std::min(distances[i] + radius[0], distances[i + 1] + radius[1]);
+			const T bound = std::min(interval.bound, std::min(ball_bound, error_bound(half, other)));
+			// Half can not be farther than the lower bound, it can not raise the distance
+			if (bound <= lower_bound){
+				if (stats) stats->pruned++;
+				continue;
+			}
+			q.push(Interval{ bound, { ends[i], ends[i + 1] }, interval.second });
+			if (stats) stats->push(q.size());
+		}
+	}
+	if (q.empty()) upper_bound = lower_bound;
+	if (stats) stats->final_gap = upper_bound - lower_bound;
+
+	result.lower_bound = lower_bound;
+	result.upper_bound = upper_bound;
+	return (upper_bound + lower_bound) / 2;
+}
+
+#endif /* _BEZIER_TREE_H_ */
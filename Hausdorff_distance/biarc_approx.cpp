@@ -1,7 +1,7 @@
 #include "biarc_approx.h"
 #include "utils.h"
 #include <limits>
-#include <GL/glut.h>
+#include <cmath>
 
 void subdivide(const CubicBezierCurve *curve, CubicBezierCurve *output1, CubicBezierCurve *output2)
 {
@@ -42,21 +42,133 @@ void subdivide(const CubicBezierCurve *curve, REAL t, CubicBezierCurve *output1,
 
 void subdivide(const CubicBezierCurve *curve, std::vector<CubicBezierCurve> &output, int power)
 {
-	std::vector<CubicBezierCurve> prev, curr;
-	curr.push_back(*curve);
-
-	for(int i = 0; i < power; i++){
-		prev = curr;
-		curr.clear();
-		for(auto subcurve: prev){
-			CubicBezierCurve curve1, curve2;
-			subdivide(&subcurve, &curve1, &curve2);
-			curr.push_back(curve1);
-			curr.push_back(curve2);
+	CurveArray curves(1 << power);
+	curves.set(0, curve);
+	curves.size = 1;
+	subdivide(curves, power);
+
+	const size_t offset = output.size();
+	output.resize(offset + curves.size);
+	for (int j = 0; j < curves.size; j++){
+		int reversed = 0;
+		for (int b = 0; b < power; b++) reversed |= ((j >> b) & 1) << (power - 1 - b);
+		curves.get(reversed, &output[offset + j]);
+	}
+}
+
+void blossom(const CubicBezierCurve *curve, REAL u1, REAL u2, REAL u3, Point value)
+{
+	Point inter1[3];
+	Point inter2[2];
+	for (int i = 0; i < 3; i++){
+		inter1[i][X] = curve->control_pts[i][X] * (1 - u1) + curve->control_pts[i + 1][X] * u1;
+		inter1[i][Y] = curve->control_pts[i][Y] * (1 - u1) + curve->control_pts[i + 1][Y] * u1;
+	}
+	for (int i = 0; i < 2; i++){
+		inter2[i][X] = inter1[i][X] * (1 - u2) + inter1[i + 1][X] * u2;
+		inter2[i][Y] = inter1[i][Y] * (1 - u2) + inter1[i + 1][Y] * u2;
+	}
+	SET_VECTOR2(value, inter2[0][X] * (1 - u3) + inter2[1][X] * u3, inter2[0][Y] * (1 - u3) + inter2[1][Y] * u3);
+}
+
+void get_leaf(const CubicBezierCurve *curve, int power, int index, CubicBezierCurve *output)
+{
+	// Parameters are exact in REAL up to power 24
+	const REAL a = std::ldexp((REAL)index, -power);
+	const REAL b = std::ldexp((REAL)(index + 1), -power);
+
+	// First step at a and at b is shared by the four blossoms
+	Point inter_a[3], inter_b[3];
+	for (int i = 0; i < 3; i++){
+		for (int k = 0; k < 2; k++){
+			inter_a[i][k] = curve->control_pts[i][k] * (1 - a) + curve->control_pts[i + 1][k] * a;
+			inter_b[i][k] = curve->control_pts[i][k] * (1 - b) + curve->control_pts[i + 1][k] * b;
+		}
+	}
+	Point inter_aa[2], inter_ab[2], inter_bb[2];
+	for (int i = 0; i < 2; i++){
+		for (int k = 0; k < 2; k++){
+			inter_aa[i][k] = inter_a[i][k] * (1 - a) + inter_a[i + 1][k] * a;
+			inter_ab[i][k] = inter_a[i][k] * (1 - b) + inter_a[i + 1][k] * b;
+			inter_bb[i][k] = inter_b[i][k] * (1 - b) + inter_b[i + 1][k] * b;
 		}
 	}
+	for (int k = 0; k < 2; k++){
+		output->control_pts[0][k] = inter_aa[0][k] * (1 - a) + inter_aa[1][k] * a;
+		output->control_pts[1][k] = inter_aa[0][k] * (1 - b) + inter_aa[1][k] * b;
+		output->control_pts[2][k] = inter_ab[0][k] * (1 - b) + inter_ab[1][k] * b;
+		output->control_pts[3][k] = inter_bb[0][k] * (1 - b) + inter_bb[1][k] * b;
+	}
+}
+
+void get_leaves(const CubicBezierCurve *curve, int power, int first, int last, CubicBezierCurve *output)
+{
+	for (int i = first; i < last; i++) get_leaf(curve, power, i, &output[i - first]);
+}
+
+void CurveArray::set(int i, const CubicBezierCurve *curve)
+{
+	for (int k = 0; k < 4; k++){
+		coords(k, X)[i] = curve->control_pts[k][X];
+		coords(k, Y)[i] = curve->control_pts[k][Y];
+	}
+}
+
+void CurveArray::get(int i, CubicBezierCurve *curve) const
+{
+	for (int k = 0; k < 4; k++) SET_VECTOR2(curve->control_pts[k], coords(k, X)[i], coords(k, Y)[i]);
+}
+
+void subdivide(CurveArray &curves, int power)
+{
+	for (int level = 0; level < power; level++){
+		const int n = curves.size;
+		for (int c = 0; c < 2; c++){
+			REAL *p0 = curves.coords(0, c), *p1 = curves.coords(1, c), *p2 = curves.coords(2, c), *p3 = curves.coords(3, c);
+			// Right halves at i + n never overlap the left halves at i within a level
+#pragma GCC ivdep
+			for (int i = 0; i < n; i++){
+				const REAL a = (p0[i] + p1[i]) * 0.5f, b = (p1[i] + p2[i]) * 0.5f, d = (p2[i] + p3[i]) * 0.5f;
+				const REAL e = (a + b) * 0.5f, f = (b + d) * 0.5f;
+				const REAL m = (e + f) * 0.5f;
+				p0[i + n] = m;
+				p1[i + n] = f;
+				p2[i + n] = d;
+				p3[i + n] = p3[i];
+				p1[i] = a;
+				p2[i] = e;
+				p3[i] = m;
+			}
+		}
+		curves.size = 2 * n;
+	}
+}
+
+void subdivide(const QuadraticBezierCurve *curve, REAL t, QuadraticBezierCurve *output1, QuadraticBezierCurve *output2)
+{
+	Point inter1[2];
+	Point inter2;
+	division_point(curve->control_pts[0], curve->control_pts[1], 1.0 - t, inter1[0]);
+	division_point(curve->control_pts[1], curve->control_pts[2], 1.0 - t, inter1[1]);
+	division_point(inter1[0], inter1[1], 1.0 - t, inter2);
+
+	copy_point(curve->control_pts[0], output1->control_pts[0]);
+	copy_point(inter1[0], output1->control_pts[1]);
+	copy_point(inter2, output1->control_pts[2]);
+
+	copy_point(inter2, output2->control_pts[0]);
+	copy_point(inter1[1], output2->control_pts[1]);
+	copy_point(curve->control_pts[2], output2->control_pts[2]);
+}
 
-	std::copy(curr.begin(), curr.end(), back_inserter(output));
+void subdivide(const LineSegment *line, REAL t, LineSegment *output1, LineSegment *output2)
+{
+	Point middle;
+	division_point(line->control_pts[0], line->control_pts[1], 1.0 - t, middle);
+	copy_point(line->control_pts[0], output1->control_pts[0]);
+	copy_point(middle, output1->control_pts[1]);
+	copy_point(middle, output2->control_pts[0]);
+	copy_point(line->control_pts[1], output2->control_pts[1]);
 }
 
 void get_tangent(const CubicBezierCurve *curve, Point &tan_begin, Point &tan_end)
@@ -239,29 +351,53 @@ void to_biarc(const CubicBezierCurve *curve, Point &inflect, Arc *arc1, Arc *arc
 	}
 }
 
-void draw_arc(const std::shared_ptr<Arc> arc){
-	glColor3ub(255, 0, 0);
-	glLineWidth(10.0);
-	if (arc->is_line()){
-		glBegin(GL_LINE_STRIP);
-		glVertex2f(arc->center[0], arc->center[1]);
-		glVertex2f(arc->center[0] + arc->begin, arc->center[1] + arc->end);
-		glEnd();
-	}
-	else {
-		glBegin(GL_LINE_STRIP);
-		for (int i = 0; i <= 100; i++)
-		{
-			Point pt;
-			const REAL t = (REAL)i / (REAL)100;
-			const REAL angle = t * (arc->end - arc->begin) + arc->begin;
-			pt[0] = arc->center[0] + arc->radius * cos(angle);
-			pt[1] = arc->center[1] + arc->radius * sin(angle);
-			glVertex2f(pt[0], pt[1]);
+void to_biarc(const CubicBezierCurve *curve, Point &inflect, VectorArc *arc1, VectorArc *arc2)
+{
+	const Point &arc1_point = curve->control_pts[0];
+	const Point &arc2_point = curve->control_pts[3];
+
+	// Only the centers are used from here
+	Arc center_arc1, center_arc2;
+	set_arc_center(curve, arc1_point, arc2_point, inflect, &center_arc1, &center_arc2);
+
+	VectorArc *arcs[2] = { arc1, arc2 };
+	const Point *centers[2] = { &center_arc1.center, &center_arc2.center };
+	const Point *begins[2] = { &arc1_point, &inflect };
+	const Point *ends[2] = { &inflect, &arc2_point };
+
+	Point arc_tan[2];
+	get_tangent(curve, arc_tan[0], arc_tan[1]);
+
+	for (int i = 0; i < 2; i++){
+		VectorArc *arc = arcs[i];
+		const Point &center = *centers[i];
+
+		// process cases where line should be used instead of arc
+		if (center[0] != center[0]){
+			set_line(arc, *begins[i], *ends[i]);
+			continue;
 		}
-		glEnd();
+
+		const Point &endpoint = i == 0 ? arc1_point : arc2_point;
+		Point r_vec;
+		subtract_point(endpoint, center, r_vec);
+		arc->kind = KIND_ARC;
+		copy_point(center, arc->center);
+		arc->radius = norm(r_vec);
+		copy_point(*begins[i], arc->begin);
+		copy_point(*ends[i], arc->end);
+
+		// If arc is going counterclock-wise, swap begin and end
+		if (r_vec[1] * arc_tan[i][0] - r_vec[0] * arc_tan[i][1] > 0.0){
+			std::swap(arc->begin[0], arc->end[0]);
+			std::swap(arc->begin[1], arc->end[1]);
+		}
+
+		Point u, v;
+		subtract_point(arc->begin, center, u);
+		subtract_point(arc->end, center, v);
+		arc->major = u[0] * v[1] - u[1] * v[0] < 0.0;
 	}
-	glLineWidth(1.0);
 }
 
 REAL distance_line(const Point p, const Point line_begin, const Point line_end){
@@ -313,211 +449,3 @@ REAL distance(const Point p, const Point line_begin, const Point line_end){
 		return ep_dis;
 	}
 }
-
-REAL distance(const std::shared_ptr<Arc> arc1, const std::shared_ptr<Arc> arc2)
-{
-	REAL d = std::numeric_limits<REAL>::max();
-	if (!arc1->is_line()){
-		if (arc2->is_line()){
-			return distance(arc2, arc1);
-		}
-		// Two arcs
-		else {
-			// Intersection check
-			REAL center_d = distance(arc1->center, arc2->center);
-			if (center_d < arc1->radius + arc2->radius
-				&& center_d > std::abs(arc1->radius - arc2->radius)){
-
-				// Find two candidate points, check if arcs contains them in a range
-				REAL angle1c1, angle1c2;
-				REAL angle2c1, angle2c2;
-				Point tangent;
-				subtract_point(arc1->center, arc2->center, tangent);
-				REAL base_angle = atan2(tangent[1], tangent[0]);
-
-				// Law of Cosines
-				REAL offset_angle_1 = acos((arc1->radius * arc1->radius + center_d * center_d - arc2->radius * arc2->radius) / 2.0 / arc1->radius / center_d);
-				REAL offset_angle_2 = acos((arc2->radius * arc2->radius + center_d * center_d - arc1->radius * arc1->radius) / 2.0 / arc2->radius / center_d);
-
-				angle1c1 = base_angle - M_PI - offset_angle_1;
-				angle1c2 = base_angle - M_PI + offset_angle_1;
-				angle2c1 = base_angle + offset_angle_2 - 2 * M_PI;
-				angle2c2 = base_angle - offset_angle_2 - 2 * M_PI;
-
-				while (angle1c1 < arc1->begin) angle1c1 += 2 * M_PI;
-				while (angle1c2 < arc1->begin) angle1c2 += 2 * M_PI;
-				while (angle2c1 < arc2->begin) angle2c1 += 2 * M_PI;
-				while (angle2c2 < arc2->begin) angle2c2 += 2 * M_PI;
-
-				if ((angle1c1 < arc1->end && angle2c1 < arc2->end) ||
-					(angle1c2 < arc1->end && angle2c2 < arc2->end)){
-					draw_arc(arc1);
-					draw_arc(arc2);
-					return 0.0;
-				}
-			}
-
-			// Check endpoint of two arcs
-			Point arc1_e1 = { arc1->center[0] + arc1->radius * cos(arc1->begin), arc1->center[1] + arc1->radius * sin(arc1->begin) };
-			Point arc1_e2 = { arc1->center[0] + arc1->radius * cos(arc1->end), arc1->center[1] + arc1->radius * sin(arc1->end) };
-			Point arc2_e1 = { arc2->center[0] + arc2->radius * cos(arc2->begin), arc2->center[1] + arc2->radius * sin(arc2->begin) };
-			Point arc2_e2 = { arc2->center[0] + arc2->radius * cos(arc2->end), arc2->center[1] + arc2->radius * sin(arc2->end) };
-	
-			d = std::min(d, distance(arc1_e1, arc2_e1));
-			d = std::min(d, distance(arc1_e1, arc2_e2));
-			d = std::min(d, distance(arc1_e2, arc2_e1));
-			d = std::min(d, distance(arc1_e2, arc2_e2));
-
-			// Check an endpoint of an arc and an interior point of the other arc, on a line connected to center
-			Point da1e1, da1e2, da2e1, da2e2;
-			subtract_point(arc2->center, arc1_e1, da1e1);
-			subtract_point(arc2->center, arc1_e2, da1e2);
-			subtract_point(arc1->center, arc2_e1, da2e1);
-			subtract_point(arc1->center, arc2_e2, da2e2);
-
-			normalize(da1e1);
-			normalize(da1e2);
-			normalize(da2e1);
-			normalize(da2e2);
-
-			REAL angle11, angle12, angle21, angle22;
-			angle11 = std::atan2(da1e1[1], da1e1[0]);
-			angle12 = std::atan2(da1e2[1], da1e2[0]);
-			angle21 = std::atan2(da2e1[1], da2e1[0]);
-			angle22 = std::atan2(da2e2[1], da2e2[0]);
-
-			if (angle11 < arc2->begin) angle11 += 2 * M_PI;
-			if (angle12 < arc2->begin) angle12 += 2 * M_PI;
-			if (angle21 < arc1->begin) angle21 += 2 * M_PI;
-			if (angle22 < arc1->begin) angle22 += 2 * M_PI;
-			if (angle11 < arc2->end){
-				Point interior = { arc2->center[0] + arc2->radius * cos(angle11), arc2->center[1] + arc2->radius * sin(angle11) };
-				d = std::min(d, distance(interior, da1e1));
-			}
-			if (angle12 < arc2->end){
-				Point interior = { arc2->center[0] + arc2->radius * cos(angle12), arc2->center[1] + arc2->radius * sin(angle12) };
-				d = std::min(d, distance(interior, da1e2));
-			}
-			if (angle21 < arc1->end){
-				Point interior = { arc1->center[0] + arc1->radius * cos(angle21), arc1->center[1] + arc1->radius * sin(angle21) };
-				d = std::min(d, distance(interior, da2e1));
-			}
-			if (angle22 < arc1->end){
-				Point interior = { arc1->center[0] + arc1->radius * cos(angle22), arc1->center[1] + arc1->radius * sin(angle22) };
-				d = std::min(d, distance(interior, da2e2));
-			}
-
-			// Check two interior points on a line connecting two center points
-			Point dc;
-			subtract_point(arc1->center, arc2->center, dc);
-			normalize(dc);
-			REAL angle1 = std::atan2(-dc[1], -dc[0]);
-			REAL angle2 = std::atan2(dc[1], dc[0]);
-
-			if (angle1 < arc1->begin) angle1 += 2 * M_PI;
-			if (angle2 < arc2->begin) angle2 += 2 * M_PI;
-			if (angle1 < arc1->end && angle2 < arc2->end){
-				Point interior1 = { arc1->center[0] + arc1->radius * cos(angle1), arc1->center[1] + arc1->radius * sin(angle1) };
-				Point interior2 = { arc2->center[0] + arc2->radius * cos(angle2), arc2->center[1] + arc2->radius * sin(angle2) };
-				d = std::min(d, distance(interior1, interior2));
-			}
-
-			return d;
-		}
-	}
-	else {
-		Point p1;
-		p1[0] = arc1->begin;
-		p1[1] = arc1->end;
-
-		// An arc and a line
-		if (!arc2->is_line()){
-			Point &line_end = p1;
-			Point &line_begin = arc1->center;
-
-			// Intersection check
-			REAL cld = distance(arc2->center, line_begin, line_end);
-			if (cld < arc2->radius){
-				Point vec;
-				subtract_point(line_end, line_begin, vec);
-
-				Point vec_perp;
-				vec_perp[0] = -vec[1];
-				vec_perp[1] = vec[0];
-
-				Point vec_to_line;
-				subtract_point(arc2->center, line_begin, vec_to_line);
-				normalize(vec_to_line);
-				normalize(vec_perp);
-				
-				REAL vec_norm = norm(vec);
-				REAL dis = (vec_to_line[0] * vec_perp[0] + vec_to_line[1] * vec_perp[1]);
-				vec_perp[0] *= dis;
-				vec_perp[1] *= dis;
-
-				REAL angle = std::atan2(vec_perp[1], vec_perp[0]);
-				REAL offset_angle = std::acos(cld / arc2->radius);
-
-				REAL angle1 = angle - offset_angle, angle2 = angle + offset_angle - 2 * M_PI;
-				while (angle1 < arc2->begin) angle1 += 2 * M_PI;
-				while (angle2 < arc2->begin) angle2 += 2 * M_PI;
-
-				Point inter1 = { arc2->center[0] + arc2->radius * cos(angle1), arc2->center[1] + arc2->radius * sin(angle1) };
-				Point inter2 = { arc2->center[0] + arc2->radius * cos(angle2), arc2->center[1] + arc2->radius * sin(angle2) };
-				if ((angle1 < arc2->end && ((inter1[0] - line_begin[0]) * (inter1[0] - line_end[0]) < 0 || (inter1[1] - line_begin[1]) * (inter1[1] - line_end[1]) < 0)) ||
-					(angle2 < arc2->end && ((inter2[0] - line_begin[0]) * (inter2[0] - line_end[0]) < 0 || (inter2[1] - line_begin[1]) * (inter2[1] - line_end[1]) < 0))){
-					draw_arc(arc1);
-					draw_arc(arc2);
-					return 0;
-				}
-
-				return 0;
-			}
-			
-			// Endpoint of arc to line
-			Point arc2_e1 = { arc2->center[0] + arc2->radius * cos(arc2->begin), arc2->center[1] + arc2->radius * sin(arc2->begin) };
-			Point arc2_e2 = { arc2->center[0] + arc2->radius * cos(arc2->end), arc2->center[1] + arc2->radius * sin(arc2->end) };
-
-			REAL center_d = distance(arc2->center, line_begin, line_end);
-			
-			d = std::min(d, distance(arc2_e1, line_begin, line_end));
-			d = std::min(d, distance(arc2_e2, line_begin, line_end));
-
-			// Interior point of arc to line
-			Point vec;
-			subtract_point(line_end, line_begin, vec);
-
-			Point vec_perp;
-			vec_perp[0] = -vec[1];
-			vec_perp[1] = vec[0];
-
-			Point vec_to_line;
-			subtract_point(arc2->center, line_begin, vec_to_line);
-			
-			REAL vec_norm = norm(vec);
-			REAL dis = (vec_to_line[0] * vec_perp[0] + vec_to_line[1] * vec_perp[1]) > 0 ? 1.0 : -1.0;
-			REAL angle = atan2(dis * vec_perp[1], dis * vec_perp[0]);
-
-			if (angle < arc2->begin) angle += 2 * M_PI;
-			if (angle < arc2->end){
-				Point interior = { arc2->center[0] + dis * arc2->radius * vec_perp[0], arc2->center[1] + dis * arc2->radius * vec_perp[1] };
-				d = std::min(d, distance(interior, line_begin, line_end));
-			}
-
-			return d;
-		}
-		// Two lines
-		else {
-			Point p2;
-			p2[0] = arc2->begin;
-			p2[1] = arc2->end;
-
-			d = std::min(d, distance(arc1->center, arc2->center, p2));
-			d = std::min(d, distance(p1, arc2->center, p2));
-			d = std::min(d, distance(p2, arc1->center, p1));
-			d = std::min(d, distance(arc2->center, arc1->center, p1));
-
-			return d;
-		}
-	}
-}
\ No newline at end of file
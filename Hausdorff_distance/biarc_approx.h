@@ -1,3 +1,6 @@
+#ifndef _BIARC_APPROX_H_
+#define _BIARC_APPROX_H_
+
 #include "curve.h"
 #include <memory>
 
@@ -7,6 +10,46 @@ void subdivide(const CubicBezierCurve *curve, REAL t, CubicBezierCurve *output1,
 
 void subdivide(const CubicBezierCurve *curve, std::vector<CubicBezierCurve> &output, int power);
 
+// Control points of cubics in structure of arrays layout in one buffer, coordinate c of control point k of curve i
+// is coords(k, c)[i]. Capacity is fixed at construction, so a batch subdivision allocates once
+class CurveArray
+{
+public:
+	int capacity;
+	int size;
+	std::vector<REAL> data;
+
+	CurveArray(int capacity = 0) : capacity(capacity), size(0), data(8 * (size_t)capacity){}
+
+	REAL *coords(int k, int c){ return data.data() + (2 * k + c) * (size_t)capacity; }
+	const REAL *coords(int k, int c) const { return data.data() + (2 * k + c) * (size_t)capacity; }
+	void set(int i, const CubicBezierCurve *curve);
+	void get(int i, CubicBezierCurve *curve) const;
+};
+
+// Splits all curves of the array power times at parameter middles, in place and level by level, the capacity must
+// be at least size << power. Each level writes the left halves over the curves and the right halves after them,
+// so that the loop over curves is contiguous and vectorizes. Leaf j of curve i ends up at i + size * reverse(j),
+// with reverse the power bit reversal of j
+void subdivide(CurveArray &curves, int power);
+
+// Blossom (polar form) of the cubic, the de Casteljau steps are taken at u1, u2 and u3. It is symmetric in its
+// arguments and blossom(t, t, t) is the point at t
+void blossom(const CubicBezierCurve *curve, REAL u1, REAL u2, REAL u3, Point value);
+
+// Leaf index of the uniform subdivision at power, the curve over [index / 2^power, (index + 1) / 2^power], with
+// control points blossom(a, a, a), blossom(a, a, b), blossom(a, b, b) and blossom(b, b, b). Each leaf is
+// computed on its own in constant time, so leaves can be made lazily or in parallel, and adjacent leaves share
+// their endpoint exactly
+void get_leaf(const CubicBezierCurve *curve, int power, int index, CubicBezierCurve *output);
+
+// Leaves first to last - 1 of the uniform subdivision at power, in order
+void get_leaves(const CubicBezierCurve *curve, int power, int first, int last, CubicBezierCurve *output);
+
+void subdivide(const QuadraticBezierCurve *curve, REAL t, QuadraticBezierCurve *output1, QuadraticBezierCurve *output2);
+
+void subdivide(const LineSegment *line, REAL t, LineSegment *output1, LineSegment *output2);
+
 void get_tangent(const CubicBezierCurve *curve, Point &tan_begin, Point &tan_end);
 
 void get_line_segs(const CubicBezierCurve *curve, Point &l1_tan, Point &l1_center, Point &l2_tan, Point &l2_center);
@@ -17,10 +60,15 @@ void get_biarc_inflect(const CubicBezierCurve *curve, Point &inflect);
 
 void to_biarc(const CubicBezierCurve *curve, Point &inflect, Arc *arc1, Arc *arc2);
 
-REAL distance(const std::shared_ptr<Arc> arc1, const std::shared_ptr<Arc> arc2);
+void to_biarc(const CubicBezierCurve *curve, Point &inflect, VectorArc *arc1, VectorArc *arc2);
+
+// Draws both arcs when they intersect, defined in draw.cpp
+REAL distance(const std::shared_ptr<Arc> &arc1, const std::shared_ptr<Arc> &arc2);
 
 REAL distance_line(const Point p, const Point line_begin, const Point line_end);
 
 REAL distance(const Point p, const Point line_begin, const Point line_end);
 
-void draw_arc(const std::shared_ptr<Arc> arc);
+void draw_arc(const std::shared_ptr<Arc> &arc);
+
+#endif /* _BIARC_APPROX_H_ */
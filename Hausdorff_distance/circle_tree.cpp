@@ -0,0 +1,116 @@
+#include "circle_tree.h"
+#include "utils.h"
+#include "tree_search.h"
+#include <queue>
+#include <limits>
+
+#define NUM_SAMPLES 10
+
+Circle get_arc_circle(const VectorArc *arc){
+	Circle res;
+	// Arc wider than half circle is bounded by its own circle
+	if (!arc->is_line() && arc->major){
+		copy_point(arc->center, res.center);
+		res.radius = arc->radius;
+	}
+	// Otherwise the circle with the chord as diameter contains the arc
+	else {
+		middle_point(arc->begin, arc->end, res.center);
+		res.radius = distance(arc->begin, arc->end) / 2.0;
+	}
+
+	return res;
+}
+
+Circle combine(const Circle &circle1, const Circle &circle2){
+	REAL center_d = distance(circle1.center, circle2.center);
+	if (center_d + circle2.radius <= circle1.radius) return circle1;
+	if (center_d + circle1.radius <= circle2.radius) return circle2;
+
+	// Smallest circle enclosing both circles
+	Circle res;
+	res.radius = (center_d + circle1.radius + circle2.radius) / 2.0;
+	REAL t = (res.radius - circle1.radius) / center_d;
+	res.center[0] = circle1.center[0] + (circle2.center[0] - circle1.center[0]) * t;
+	res.center[1] = circle1.center[1] + (circle2.center[1] - circle1.center[1]) * t;
+
+	return res;
+}
+
+REAL distance(const Circle &circle1, const Circle &circle2){
+	REAL d = distance(circle1.center, circle2.center) - circle1.radius - circle2.radius;
+	return d > 0.0 ? d : 0.0;
+}
+
+bool test_circle_collision(const Circle &circle1, const Circle &circle2){
+	Point d;
+	subtract_point(circle1.center, circle2.center, d);
+	REAL r = circle1.radius + circle2.radius;
+
+	return d[0] * d[0] + d[1] * d[1] <= r * r;
+}
+
+void build_hierarchy(std::shared_ptr<CircleHierarchy> h, int power){
+	const CubicBezierCurve &seg = h->curve;
+
+	auto leftH = std::make_shared<CircleHierarchy>();
+	auto rightH = std::make_shared<CircleHierarchy>();
+
+	// Straight segment is covered exactly by lines, as in the box hierarchy
+	REAL deviation;
+	const bool straight = is_straight(&seg, deviation);
+	if (power == 0 || straight){
+		CubicBezierCurve segs[2];
+		VectorArc arcs[2];
+		REAL errors[2];
+		if (straight){
+			subdivide(&seg, &segs[0], &segs[1]);
+			set_line(&arcs[0], seg.control_pts[0], segs[0].control_pts[3]);
+			set_line(&arcs[1], segs[1].control_pts[0], seg.control_pts[3]);
+			errors[0] = errors[1] = deviation;
+		}
+		else get_leaf_arcs(seg, segs, arcs, errors);
+
+		leftH->curve = segs[0];
+		rightH->curve = segs[1];
+		leftH->circle = get_arc_circle(&arcs[0]);
+		rightH->circle = get_arc_circle(&arcs[1]);
+		leftH->circle.radius += errors[0];
+		rightH->circle.radius += errors[1];
+		leftH->arc = std::make_shared<VectorArc>(arcs[0]);
+		rightH->arc = std::make_shared<VectorArc>(arcs[1]);
+		leftH->error = errors[0];
+		rightH->error = errors[1];
+	}
+	else {
+		subdivide(&seg, &leftH->curve, &rightH->curve);
+		build_hierarchy(leftH, power - 1);
+		build_hierarchy(rightH, power - 1);
+	}
+	h->circle = combine(leftH->circle, rightH->circle);
+	h->left = leftH;
+	h->right = rightH;
+}
+
+REAL minimum_distance(std::shared_ptr<CircleHierarchy> tree1, std::shared_ptr<CircleHierarchy> tree2, MinDistanceResult &result, SearchStats *stats, const SearchBudget *budget){
+	// Circle with larger radius is divided
+	return tree_minimum_distance(tree1, tree2, NUM_SAMPLES, result, stats, budget,
+		[](const CircleHierarchy &node1, const CircleHierarchy &node2){ return distance(node1.circle, node2.circle); },
+		[](const CircleHierarchy &node){ return node.circle.radius; },
+		[](const CircleHierarchy &node){ return 2.0 * node.circle.radius; });
+}
+void intersection(std::shared_ptr<CircleHierarchy> tree1, std::shared_ptr<CircleHierarchy> tree2, std::vector<curve_pair> &output){
+	if (!test_circle_collision(tree1->circle, tree2->circle)) return;
+
+	if (tree1->left != nullptr && (tree2->left == nullptr || tree1->circle.radius > tree2->circle.radius)){
+		intersection(tree1->left, tree2, output);
+		intersection(tree1->right, tree2, output);
+	}
+	else if (tree2->left != nullptr){
+		intersection(tree1, tree2->left, output);
+		intersection(tree1, tree2->right, output);
+	}
+	else {
+		output.push_back(std::make_pair(tree1->curve, tree2->curve));
+	}
+}
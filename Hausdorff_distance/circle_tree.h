@@ -0,0 +1,38 @@
+#ifndef _CIRCLE_TREE_H_
+#define _CIRCLE_TREE_H_
+
+#include "hierarchy.h"
+
+class Circle {
+public:
+	Point center;
+	REAL radius;
+};
+
+// Same layout as Hierarchy, bounded by circles instead of AABBs
+class CircleHierarchy {
+public:
+	CubicBezierCurve curve;
+	Circle circle;
+	std::shared_ptr<CircleHierarchy> left = nullptr;
+	std::shared_ptr<CircleHierarchy> right = nullptr;
+	std::shared_ptr<VectorArc> arc = nullptr;
+	REAL error = 0.0;   /* approximation error of the leaf arc, the circle is inflated by it */
+};
+
+Circle get_arc_circle(const VectorArc *arc);
+
+Circle combine(const Circle &circle1, const Circle &circle2);
+
+REAL distance(const Circle &circle1, const Circle &circle2);
+
+bool test_circle_collision(const Circle &circle1, const Circle &circle2);
+
+void build_hierarchy(std::shared_ptr<CircleHierarchy> h, int power);
+
+REAL minimum_distance(std::shared_ptr<CircleHierarchy> tree1, std::shared_ptr<CircleHierarchy> tree2, MinDistanceResult &result,
+	SearchStats *stats = nullptr, const SearchBudget *budget = nullptr);
+
+void intersection(std::shared_ptr<CircleHierarchy> tree1, std::shared_ptr<CircleHierarchy> tree2, std::vector<curve_pair> &output);
+
+#endif /* _CIRCLE_TREE_H_ */
@@ -0,0 +1,164 @@
+#include "corpus.h"
+#include "utils.h"
+
+void random_curve(std::mt19937 &gen, CubicBezierCurve &curve, REAL size){
+	std::uniform_real_distribution<REAL> coord(0.0, size);
+	for (int i = 0; i < 4; i++){
+		SET_PT2(curve.control_pts[i], coord(gen), coord(gen));
+	}
+}
+
+void random_curves(unsigned int seed, int num_curves, std::vector<CubicBezierCurve> &output){
+	std::mt19937 gen(seed);
+	for (int i = 0; i < num_curves; i++){
+		CubicBezierCurve curve;
+		random_curve(gen, curve);
+		output.push_back(curve);
+	}
+}
+
+void random_space_curves(unsigned int seed, int num_curves, std::vector<Bezier<3, REAL, 3>> &output, REAL size){
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<REAL> coord(0.0, size);
+	for (int i = 0; i < num_curves; i++){
+		Bezier<3, REAL, 3> curve;
+		for (int j = 0; j <= 3; j++){
+			for (int k = 0; k < 3; k++) curve.control_pts[j][k] = coord(gen);
+		}
+		output.push_back(curve);
+	}
+}
+
+const char *pair_kind_name(PairKind kind){
+	switch (kind){
+	case PAIR_NEAR_TOUCHING: return "near";
+	case PAIR_CROSSING: return "cross";
+	case PAIR_FAR_APART: return "far";
+	case PAIR_CUSPED: return "cusp";
+	case PAIR_DEGENERATE: return "degen";
+	default: return "unknown";
+	}
+}
+
+// Rotate by angle, scale and move the curve defined in the unit square
+static void place_curve(CubicBezierCurve &curve, REAL angle, REAL scale, REAL x, REAL y){
+	REAL c = std::cos(angle), s = std::sin(angle);
+	for (int i = 0; i < 4; i++){
+		REAL px = curve.control_pts[i][0] * scale, py = curve.control_pts[i][1] * scale;
+		SET_PT2(curve.control_pts[i], x + c * px - s * py, y + s * px + c * py);
+	}
+}
+
+void random_pair(std::mt19937 &gen, PairKind kind, CubicBezierCurve &curve1, CubicBezierCurve &curve2, REAL size){
+	std::uniform_real_distribution<REAL> unit(0.0, 1.0);
+	std::uniform_real_distribution<REAL> angle(0.0, 2.0 * M_PI);
+	REAL scale = size * (0.2 + 0.3 * unit(gen));
+	REAL rot = angle(gen);
+	REAL x = size * (0.25 + 0.5 * unit(gen)), y = size * (0.25 + 0.5 * unit(gen));
+
+	switch (kind){
+	case PAIR_NEAR_TOUCHING: {
+		// Apex of both arches is at x = 0.5, the gap is log-uniform
+		REAL gap = std::pow((REAL)10.0, -3.0 + 3.0 * unit(gen)) / scale;
+		REAL h1 = 0.2 + 0.6 * unit(gen), h2 = 0.2 + 0.6 * unit(gen);
+		SET_PT2(curve1.control_pts[0], -0.5, gap + h1);
+		SET_PT2(curve1.control_pts[1], -0.2, gap - h1 / 3.0);
+		SET_PT2(curve1.control_pts[2], 0.2, gap - h1 / 3.0);
+		SET_PT2(curve1.control_pts[3], 0.5, gap + h1);
+		SET_PT2(curve2.control_pts[0], -0.5, -h2);
+		SET_PT2(curve2.control_pts[1], -0.2, h2 / 3.0);
+		SET_PT2(curve2.control_pts[2], 0.2, h2 / 3.0);
+		SET_PT2(curve2.control_pts[3], 0.5, -h2);
+		place_curve(curve1, rot, scale, x, y);
+		place_curve(curve2, rot, scale, x, y);
+		break;
+	}
+	case PAIR_CROSSING: {
+		// Second curve is moved so that its point at s lies on the first curve at t
+		random_curve(gen, curve1, size);
+		random_curve(gen, curve2, size);
+		Point p1, p2;
+		evaluate(&curve1, 0.1 + 0.8 * unit(gen), p1);
+		evaluate(&curve2, 0.1 + 0.8 * unit(gen), p2);
+		for (int i = 0; i < 4; i++){
+			curve2.control_pts[i][0] += p1[0] - p2[0];
+			curve2.control_pts[i][1] += p1[1] - p2[1];
+		}
+		break;
+	}
+	case PAIR_FAR_APART:
+		random_curve(gen, curve1, size);
+		random_curve(gen, curve2, size);
+		for (int i = 0; i < 4; i++){
+			curve2.control_pts[i][0] += size * (2.0 + 8.0 * unit(gen));
+			curve2.control_pts[i][1] += size * (2.0 + 8.0 * unit(gen));
+		}
+		break;
+	case PAIR_CUSPED:
+		// Derivative of (0,0) (1,1) (0,1) (1,0) vanishes at t = 0.5
+		SET_PT2(curve1.control_pts[0], 0.0, 0.0);
+		SET_PT2(curve1.control_pts[1], 1.0, 1.0);
+		SET_PT2(curve1.control_pts[2], 0.0, 1.0);
+		SET_PT2(curve1.control_pts[3], 1.0, 0.0);
+		place_curve(curve1, rot, scale, x, y);
+		random_curve(gen, curve2, size);
+		break;
+	case PAIR_DEGENERATE:
+	default: {
+		random_curve(gen, curve2, size);
+		Point begin, end;
+		SET_PT2(begin, x, y);
+		SET_PT2(end, x + scale * std::cos(rot), y + scale * std::sin(rot));
+		int variant = (int)(unit(gen) * 3.0);
+		for (int i = 0; i < 4; i++){
+			REAL t;
+			if (variant == 0) t = 0.0;
+			else if (variant == 1) t = unit(gen);
+			else t = i < 2 ? 0.0 : 1.0;
+			SET_PT2(curve1.control_pts[i], begin[0] + t * (end[0] - begin[0]), begin[1] + t * (end[1] - begin[1]));
+		}
+		break;
+	}
+	}
+}
+
+void random_pairs(unsigned int seed, PairKind kind, int num_pairs, std::vector<CubicBezierCurve> &output1, std::vector<CubicBezierCurve> &output2){
+	std::mt19937 gen(seed + kind);
+	for (int i = 0; i < num_pairs; i++){
+		CubicBezierCurve curve1, curve2;
+		random_pair(gen, kind, curve1, curve2);
+		output1.push_back(curve1);
+		output2.push_back(curve2);
+	}
+}
+
+void random_scene(unsigned int seed, int num_curves, REAL curve_size, REAL extent, std::vector<CubicBezierCurve> &output){
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<REAL> coord(0.0, extent - curve_size);
+	for (int i = 0; i < num_curves; i++){
+		CubicBezierCurve curve;
+		random_curve(gen, curve, curve_size);
+		REAL x = coord(gen), y = coord(gen);
+		for (int j = 0; j < 4; j++){
+			curve.control_pts[j][0] += x;
+			curve.control_pts[j][1] += y;
+		}
+		output.push_back(curve);
+	}
+}
+
+void random_path(unsigned int seed, int num_segments, REAL segment_size, std::vector<CubicBezierCurve> &output){
+	std::mt19937 gen(seed);
+	Point end = { 0.0, 0.0 };
+	for (int i = 0; i < num_segments; i++){
+		CubicBezierCurve curve;
+		random_curve(gen, curve, segment_size);
+		REAL x = end[0] - curve.control_pts[0][0], y = end[1] - curve.control_pts[0][1];
+		for (int j = 0; j < 4; j++){
+			curve.control_pts[j][0] += x;
+			curve.control_pts[j][1] += y;
+		}
+		copy_point(curve.control_pts[3], end);
+		output.push_back(curve);
+	}
+}
@@ -0,0 +1,43 @@
+#ifndef _CORPUS_H_
+#define _CORPUS_H_
+
+#include <random>
+#include <vector>
+#include "curve.h"
+#include "bezier.h"
+
+#define CORPUS_SEED 20211130
+
+// Control points are uniformly distributed in [0, size) x [0, size)
+void random_curve(std::mt19937 &gen, CubicBezierCurve &curve, REAL size = 1000.0);
+
+void random_curves(unsigned int seed, int num_curves, std::vector<CubicBezierCurve> &output);
+
+// Cubic space curves with control points uniformly distributed in [0, size)^3
+void random_space_curves(unsigned int seed, int num_curves, std::vector<Bezier<3, REAL, 3>> &output, REAL size = 1000.0);
+
+enum PairKind {
+	PAIR_NEAR_TOUCHING = 0,
+	PAIR_CROSSING,
+	PAIR_FAR_APART,
+	PAIR_CUSPED,
+	PAIR_DEGENERATE,
+	NUM_PAIR_KINDS
+};
+
+const char *pair_kind_name(PairKind kind);
+
+// Near touching pairs are two opposite convex arches whose apexes are within [1e-3, 1] of each other,
+// cusped pairs have a cusp at t = 0.5 of the first curve, degenerate first curves are a point, a segment
+// with collinear control points or a segment with coincident end tangents
+void random_pair(std::mt19937 &gen, PairKind kind, CubicBezierCurve &curve1, CubicBezierCurve &curve2, REAL size = 1000.0);
+
+// Curves of size curve_size at uniformly distributed positions in [0, extent) x [0, extent)
+void random_scene(unsigned int seed, int num_curves, REAL curve_size, REAL extent, std::vector<CubicBezierCurve> &output);
+
+// Segments of size segment_size from the origin, each starting at the end of the previous one
+void random_path(unsigned int seed, int num_segments, REAL segment_size, std::vector<CubicBezierCurve> &output);
+
+void random_pairs(unsigned int seed, PairKind kind, int num_pairs, std::vector<CubicBezierCurve> &output1, std::vector<CubicBezierCurve> &output2);
+
+#endif /* _CORPUS_H_ */
@@ -15,6 +15,22 @@ bool Arc::is_line() const{
 	return this->radius != this->radius;
 }
 
+bool VectorArc::is_line() const{
+	return this->kind == KIND_LINE;
+}
+
+// Check if direction from the center is within the arc, using cross products only
+bool VectorArc::contains(const Point &dir) const{
+	Point u, v;
+	subtract_point(this->begin, this->center, u);
+	subtract_point(this->end, this->center, v);
+	REAL cross_u = u[0] * dir[1] - u[1] * dir[0];
+	REAL cross_v = dir[0] * v[1] - dir[1] * v[0];
+
+	if (this->major) return cross_u >= 0 || cross_v >= 0;
+	return cross_u >= 0 && cross_v >= 0 && (cross_u > 0 || u[0] * dir[0] + u[1] * dir[1] > 0);
+}
+
 void evaluate(const CubicBezierCurve *curve, const REAL t, Point value)
 {
 	const REAL t_inv = 1.0f - t;
@@ -31,6 +47,174 @@ void evaluate(const CubicBezierCurve *curve, const REAL t, Point value)
 	VECTOR2_X_SCALA_ADD(value, curve->control_pts[3], b3);
 }
 
+void evaluate_derivative(const CubicBezierCurve *curve, const REAL t, Point value)
+{
+	const REAL t_inv = 1.0f - t;
+	const REAL b0 = 3 * t_inv * t_inv;
+	const REAL b1 = 6 * t_inv * t;
+	const REAL b2 = 3 * t * t;
+	Point d0, d1, d2;
+	subtract_point(curve->control_pts[1], curve->control_pts[0], d0);
+	subtract_point(curve->control_pts[2], curve->control_pts[1], d1);
+	subtract_point(curve->control_pts[3], curve->control_pts[2], d2);
+	SET_VECTOR2(value, 0, 0);
+	VECTOR2_X_SCALA_ADD(value, d0, b0);
+	VECTOR2_X_SCALA_ADD(value, d1, b1);
+	VECTOR2_X_SCALA_ADD(value, d2, b2);
+}
+
+void evaluate(const QuadraticBezierCurve *curve, const REAL t, Point value)
+{
+	const REAL t_inv = 1.0f - t;
+	const REAL b0 = t_inv * t_inv;
+	const REAL b1 = 2 * t_inv * t;
+	const REAL b2 = t * t;
+	SET_VECTOR2(value, 0, 0);
+	VECTOR2_X_SCALA_ADD(value, curve->control_pts[0], b0);
+	VECTOR2_X_SCALA_ADD(value, curve->control_pts[1], b1);
+	VECTOR2_X_SCALA_ADD(value, curve->control_pts[2], b2);
+}
+
+void evaluate_derivative(const QuadraticBezierCurve *curve, const REAL t, Point value)
+{
+	Point d0, d1;
+	subtract_point(curve->control_pts[1], curve->control_pts[0], d0);
+	subtract_point(curve->control_pts[2], curve->control_pts[1], d1);
+	SET_VECTOR2(value, 0, 0);
+	VECTOR2_X_SCALA_ADD(value, d0, 2 * (1.0f - t));
+	VECTOR2_X_SCALA_ADD(value, d1, 2 * t);
+}
+
+void evaluate(const LineSegment *line, const REAL t, Point value)
+{
+	SET_VECTOR2(value, 0, 0);
+	VECTOR2_X_SCALA_ADD(value, line->control_pts[0], 1.0f - t);
+	VECTOR2_X_SCALA_ADD(value, line->control_pts[1], t);
+}
+
+void evaluate_derivative(const LineSegment *line, const REAL, Point value)
+{
+	SET_VECTOR2(value, line->control_pts[1][0] - line->control_pts[0][0], line->control_pts[1][1] - line->control_pts[0][1]);
+}
+
+void elevate(const QuadraticBezierCurve *curve, CubicBezierCurve *output)
+{
+	copy_point(curve->control_pts[0], output->control_pts[0]);
+	division_point(curve->control_pts[0], curve->control_pts[1], 1.0 / 3.0, output->control_pts[1]);
+	division_point(curve->control_pts[1], curve->control_pts[2], 2.0 / 3.0, output->control_pts[2]);
+	copy_point(curve->control_pts[2], output->control_pts[3]);
+}
+
+void elevate(const LineSegment *line, CubicBezierCurve *output)
+{
+	copy_point(line->control_pts[0], output->control_pts[0]);
+	division_point(line->control_pts[0], line->control_pts[1], 2.0 / 3.0, output->control_pts[1]);
+	division_point(line->control_pts[0], line->control_pts[1], 1.0 / 3.0, output->control_pts[2]);
+	copy_point(line->control_pts[1], output->control_pts[3]);
+}
+
+void to_polynomial(const CubicBezierCurve *curve, PolynomialCurve *output)
+{
+	const Point *p = curve->control_pts;
+	for (int k = 0; k < 2; k++){
+		output->coeffs[0][k] = (p[0][k] + 3 * (p[1][k] + p[2][k]) + p[3][k]) / 8;
+		output->coeffs[1][k] = 0.75f * (p[3][k] + p[2][k] - p[1][k] - p[0][k]);
+		output->coeffs[2][k] = 1.5f * (p[3][k] - p[2][k] - p[1][k] + p[0][k]);
+		output->coeffs[3][k] = p[3][k] - 3 * p[2][k] + 3 * p[1][k] - p[0][k];
+		output->derivative_coeffs[0][k] = output->coeffs[1][k];
+		output->derivative_coeffs[1][k] = 2 * output->coeffs[2][k];
+		output->derivative_coeffs[2][k] = 3 * output->coeffs[3][k];
+		output->second_derivative_coeffs[0][k] = output->derivative_coeffs[1][k];
+		output->second_derivative_coeffs[1][k] = 2 * output->derivative_coeffs[2][k];
+	}
+}
+
+void evaluate(const PolynomialCurve *curve, const REAL t, Point value)
+{
+	const REAL s = t - 0.5f;
+	SET_VECTOR2(value,
+		((curve->coeffs[3][X] * s + curve->coeffs[2][X]) * s + curve->coeffs[1][X]) * s + curve->coeffs[0][X],
+		((curve->coeffs[3][Y] * s + curve->coeffs[2][Y]) * s + curve->coeffs[1][Y]) * s + curve->coeffs[0][Y]);
+}
+
+void evaluate_derivative(const PolynomialCurve *curve, const REAL t, Point value)
+{
+	const REAL s = t - 0.5f;
+	SET_VECTOR2(value,
+		(curve->derivative_coeffs[2][X] * s + curve->derivative_coeffs[1][X]) * s + curve->derivative_coeffs[0][X],
+		(curve->derivative_coeffs[2][Y] * s + curve->derivative_coeffs[1][Y]) * s + curve->derivative_coeffs[0][Y]);
+}
+
+void evaluate_second_derivative(const PolynomialCurve *curve, const REAL t, Point value)
+{
+	const REAL s = t - 0.5f;
+	SET_VECTOR2(value,
+		curve->second_derivative_coeffs[1][X] * s + curve->second_derivative_coeffs[0][X],
+		curve->second_derivative_coeffs[1][Y] * s + curve->second_derivative_coeffs[0][Y]);
+}
+
+void evaluate(const PolynomialCurve *curve, const int num_samples, REAL *xs, REAL *ys)
+{
+	const REAL step = 1.0 / num_samples;
+	for (int i = 0; i <= num_samples; i++){
+		const REAL s = i * step - 0.5f;
+		xs[i] = ((curve->coeffs[3][X] * s + curve->coeffs[2][X]) * s + curve->coeffs[1][X]) * s + curve->coeffs[0][X];
+		ys[i] = ((curve->coeffs[3][Y] * s + curve->coeffs[2][Y]) * s + curve->coeffs[1][Y]) * s + curve->coeffs[0][Y];
+	}
+}
+
+void evaluate(const PolynomialCurve *curve, const REAL *ts, const int num_ts, REAL *xs, REAL *ys)
+{
+	for (int i = 0; i < num_ts; i++){
+		const REAL s = ts[i] - 0.5f;
+		xs[i] = ((curve->coeffs[3][X] * s + curve->coeffs[2][X]) * s + curve->coeffs[1][X]) * s + curve->coeffs[0][X];
+		ys[i] = ((curve->coeffs[3][Y] * s + curve->coeffs[2][Y]) * s + curve->coeffs[1][Y]) * s + curve->coeffs[0][Y];
+	}
+}
+
+void subcurve(const PolynomialCurve *curve, const REAL t1, const REAL t2, CubicBezierCurve *output)
+{
+	// Over u in [0, 1] the curve is a + b u + c u^2 + d u^3 with a = value(t1), b = value'(t1) h,
+	// c = value''(t1) h^2 / 2 and d = coeffs[3] h^3 for h = t2 - t1, the last control point is value(t2)
+	const REAL h = t2 - t1;
+	Point a, b, c;
+	evaluate(curve, t1, a);
+	evaluate_derivative(curve, t1, b);
+	evaluate_second_derivative(curve, t1, c);
+	for (int k = 0; k < 2; k++){
+		b[k] *= h;
+		c[k] *= h * h / 2;
+	}
+	copy_point(a, output->control_pts[0]);
+	SET_VECTOR2(output->control_pts[1], a[X] + b[X] / 3, a[Y] + b[Y] / 3);
+	SET_VECTOR2(output->control_pts[2], a[X] + (2 * b[X] + c[X]) / 3, a[Y] + (2 * b[Y] + c[Y]) / 3);
+	evaluate(curve, t2, output->control_pts[3]);
+}
+
+bool is_straight(const CubicBezierCurve *curve, REAL &deviation)
+{
+	Point chord;
+	subtract_point(curve->control_pts[3], curve->control_pts[0], chord);
+	const REAL length_sq = chord[0] * chord[0] + chord[1] * chord[1];
+	if (length_sq == 0.0) return false;
+	const REAL length = std::sqrt(length_sq);
+
+	// Tolerance follows the resolution of REAL at the coordinates
+	REAL scale = 1.0;
+	for (int i = 0; i < 4; i++){
+		scale = std::max(scale, std::max(std::abs(curve->control_pts[i][0]), std::abs(curve->control_pts[i][1])));
+	}
+	deviation = 0.0;
+	for (int i = 1; i < 3; i++){
+		Point v;
+		subtract_point(curve->control_pts[i], curve->control_pts[0], v);
+		const REAL along = v[0] * chord[0] + v[1] * chord[1];
+		if (along < 0.0 || along > length_sq) return false;
+		deviation = std::max(deviation, std::abs(v[0] * chord[1] - v[1] * chord[0]) / length);
+	}
+	return deviation <= EPS * scale;
+}
+
 void division_point(const Point p1, const Point p2, const REAL t, Point &p_out)
 {
 	p_out[0] = (p1[0] * t + p2[0] * (1.0 - t));
@@ -139,3 +323,47 @@ REAL atan(Point &p)
 {
 	return std::atan2(p[1], p[0]);
 }
+
+void set_line(VectorArc *arc, const Point &begin, const Point &end)
+{
+	arc->kind = KIND_LINE;
+	copy_point(begin, arc->begin);
+	copy_point(end, arc->end);
+	middle_point(begin, end, arc->center);
+	arc->radius = 0.0;
+	arc->major = false;
+}
+
+void to_vector_arc(const Arc *arc, VectorArc *output)
+{
+	if (arc->is_line()){
+		Point line_end = { arc->begin, arc->end };
+		set_line(output, arc->center, line_end);
+		return;
+	}
+	output->kind = KIND_ARC;
+	copy_point(arc->center, output->center);
+	output->radius = arc->radius;
+	SET_VECTOR2(output->begin, arc->center[0] + arc->radius * cos(arc->begin), arc->center[1] + arc->radius * sin(arc->begin));
+	SET_VECTOR2(output->end, arc->center[0] + arc->radius * cos(arc->end), arc->center[1] + arc->radius * sin(arc->end));
+	output->major = arc->end - arc->begin > M_PI;
+}
+
+void to_arc(const VectorArc *arc, Arc *output)
+{
+	if (arc->is_line()){
+		output->radius = NAN;
+		copy_point(arc->begin, output->center);
+		output->begin = arc->end[0];
+		output->end = arc->end[1];
+		return;
+	}
+	copy_point(arc->center, output->center);
+	output->radius = arc->radius;
+	Point u, v;
+	subtract_point(arc->begin, arc->center, u);
+	subtract_point(arc->end, arc->center, v);
+	output->begin = atan(u);
+	output->end = atan(v);
+	if (output->end < output->begin) output->end += 2 * M_PI;
+}
@@ -15,6 +15,27 @@ typedef struct CubicBezierCurve
 	Point control_pts[4];
 } CubicBezierCurve;
 
+typedef struct QuadraticBezierCurve
+{
+	Point control_pts[3];
+} QuadraticBezierCurve;
+
+typedef struct LineSegment
+{
+	Point control_pts[2];
+} LineSegment;
+
+// Power basis coefficients of a cubic about the parameter middle, value(t) = sum coeffs[k] (t - 1/2)^k, for curves
+// evaluated many times. First and second derivatives are kept as well, each evaluation is a Horner loop without
+// Bernstein weights. Expansion about t = 0 loses two bits of REAL to cancellation, about 1/2 it is as accurate as
+// de Casteljau
+typedef struct PolynomialCurve
+{
+	Point coeffs[4];
+	Point derivative_coeffs[3];
+	Point second_derivative_coeffs[2];
+} PolynomialCurve;
+
 class Arc
 {
 public:
@@ -26,6 +47,24 @@ public:
 	bool is_line() const;
 };
 
+enum PrimitiveKind { KIND_ARC = 0, KIND_LINE };
+
+// Arc or line stored with endpoint vectors instead of angles, arc is going counterclockwise from begin to end
+// major is set if the arc is wider than half circle, center and radius are unused for a line
+class VectorArc
+{
+public:
+	PrimitiveKind kind;
+	Point center;
+	REAL radius;
+	Point begin;
+	Point end;
+	bool major;
+
+	bool is_line() const;
+	bool contains(const Point &dir) const;
+};
+
 #ifdef DEBUG
 void PRINT_CTRLPTS(CubicBezierCurve* crv);
 #else
@@ -37,6 +76,44 @@ void PRINT_CTRLPTS(CubicBezierCurve* crv);
 
 void evaluate(const CubicBezierCurve *curve, const REAL t, Point value);
 
+void evaluate_derivative(const CubicBezierCurve *curve, const REAL t, Point value);
+
+void evaluate(const QuadraticBezierCurve *curve, const REAL t, Point value);
+
+void evaluate_derivative(const QuadraticBezierCurve *curve, const REAL t, Point value);
+
+void evaluate(const LineSegment *line, const REAL t, Point value);
+
+void evaluate_derivative(const LineSegment *line, const REAL t, Point value);
+
+void to_polynomial(const CubicBezierCurve *curve, PolynomialCurve *output);
+
+void evaluate(const PolynomialCurve *curve, const REAL t, Point value);
+
+void evaluate_derivative(const PolynomialCurve *curve, const REAL t, Point value);
+
+void evaluate_second_derivative(const PolynomialCurve *curve, const REAL t, Point value);
+
+// Batch evaluation at num_samples + 1 uniform parameters i / num_samples, coordinates are written to xs and ys
+void evaluate(const PolynomialCurve *curve, const int num_samples, REAL *xs, REAL *ys);
+
+// Batch evaluation at the num_ts parameters of ts
+void evaluate(const PolynomialCurve *curve, const REAL *ts, const int num_ts, REAL *xs, REAL *ys);
+
+// Control points of the curve over [t1, t2] from the Taylor expansion at t1, without the two subdivisions of
+// subcurve_by_endpoint and the division by 1 - t1
+void subcurve(const PolynomialCurve *curve, const REAL t1, const REAL t2, CubicBezierCurve *output);
+
+// Exact degree elevation, the cubic has the same shape and parameterization
+void elevate(const QuadraticBezierCurve *curve, CubicBezierCurve *output);
+
+void elevate(const LineSegment *line, CubicBezierCurve *output);
+
+// True if the control points are on the chord within deviation, and the inner ones are between the endpoints
+// along it, so that the curve covers the chord once like an elevated line. Deviation is the largest distance
+// of a control point from the chord
+bool is_straight(const CubicBezierCurve *curve, REAL &deviation);
+
 void middle_point(const Point p1, const Point p2, Point &p_out);
 
 void division_point(const Point p1, const Point p2, const REAL t, Point &p_out);
@@ -59,4 +136,10 @@ void get_line_intersection(const Point &l1_tan, const Point &l1_center, const Po
 
 REAL atan(Point &p);
 
+void set_line(VectorArc *arc, const Point &begin, const Point &end);
+
+void to_vector_arc(const Arc *arc, VectorArc *output);
+
+void to_arc(const VectorArc *arc, Arc *output);
+
 #endif /* _CURVE_H_ */
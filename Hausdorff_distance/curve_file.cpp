@@ -0,0 +1,129 @@
+#include "curve_file.h"
+#include <stdio.h>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static uint64_t align(uint64_t offset){
+	return (offset + CURVE_FILE_ALIGNMENT - 1) / CURVE_FILE_ALIGNMENT * CURVE_FILE_ALIGNMENT;
+}
+
+static bool write_padding(FILE *f, uint64_t &offset){
+	static const char zeros[CURVE_FILE_ALIGNMENT] = { 0 };
+	uint64_t aligned = align(offset);
+	bool valid = fwrite(zeros, 1, aligned - offset, f) == aligned - offset;
+	offset = aligned;
+	return valid;
+}
+
+// True if count items of item_size bytes from offset fit in size bytes, without overflow of the end
+static bool block_fits(uint64_t offset, uint64_t count, uint64_t item_size, uint64_t size){
+	return offset <= size && count <= (size - offset) / item_size;
+}
+
+bool write_curve_file(const char *path, const std::vector<CubicBezierCurve> &curves, const StreamRecord *records){
+	FILE *f = fopen(path, "wb");
+	if (f == nullptr) return false;
+
+	const uint64_t n = curves.size();
+	CurveFileHeader header;
+	header.magic = CURVE_FILE_MAGIC;
+	header.version = CURVE_FILE_VERSION;
+	header.num_curves = n;
+	header.record_size = records ? sizeof(StreamRecord) : 0;
+	header.points_offset = align(sizeof(CurveFileHeader));
+	header.records_offset = records ? align(header.points_offset + 8 * n * sizeof(REAL)) : 0;
+	// A short write fails the whole file, fclose still runs to release it
+	bool valid = fwrite(&header, sizeof(CurveFileHeader), 1, f) == 1;
+	uint64_t offset = sizeof(CurveFileHeader);
+	valid = valid && write_padding(f, offset);
+
+	std::vector<REAL> coords(n);
+	for (int k = 0; valid && k < 2; k++){
+		for (int j = 0; valid && j < 4; j++){
+			for (uint64_t i = 0; i < n; i++) coords[i] = curves[i].control_pts[j][k];
+			valid = fwrite(coords.data(), sizeof(REAL), n, f) == n;
+			offset += n * sizeof(REAL);
+		}
+	}
+	if (valid && records){
+		valid = write_padding(f, offset) && fwrite(records, sizeof(StreamRecord), n, f) == n;
+	}
+	return fclose(f) == 0 && valid;
+}
+
+bool open_curve_file(const char *path, CurveFile &file){
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(CurveFileHeader)){
+		close(fd);
+		return false;
+	}
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) return false;
+
+	const uint64_t size = st.st_size;
+	const CurveFileHeader &header = *(const CurveFileHeader *)data;
+	const uint64_t n = header.num_curves;
+	bool valid = header.magic == CURVE_FILE_MAGIC && header.version == CURVE_FILE_VERSION &&
+		header.points_offset % CURVE_FILE_ALIGNMENT == 0 && block_fits(header.points_offset, n, 8 * sizeof(REAL), size);
+	if (valid && header.records_offset != 0){
+		valid = header.record_size == sizeof(StreamRecord) && header.records_offset % CURVE_FILE_ALIGNMENT == 0 &&
+			block_fits(header.records_offset, n, sizeof(StreamRecord), size);
+	}
+	if (!valid){
+		munmap(data, size);
+		return false;
+	}
+
+	file.data = data;
+	file.size = size;
+	file.num_curves = n;
+	const REAL *points = (const REAL *)((const char *)data + header.points_offset);
+	for (int j = 0; j < 4; j++){
+		file.x[j] = points + j * n;
+		file.y[j] = points + (4 + j) * n;
+	}
+	file.records = header.records_offset ? (const StreamRecord *)((const char *)data + header.records_offset) : nullptr;
+	return true;
+}
+
+void close_curve_file(CurveFile &file){
+	if (file.data) munmap(file.data, file.size);
+	file = CurveFile();
+}
+
+CubicBezierCurve get_curve(const CurveFile &file, int i){
+	CubicBezierCurve curve;
+	for (int j = 0; j < 4; j++){
+		SET_PT2(curve.control_pts[j], file.x[j][i], file.y[j][i]);
+	}
+	return curve;
+}
+
+static bool overlap(const AABB &box1, const AABB &box2){
+	return box1.x[0] <= box2.x[1] && box2.x[0] <= box1.x[1] && box1.y[0] <= box2.y[1] && box2.y[0] <= box1.y[1];
+}
+
+void query_box(const CurveFile &file, const AABB &box, std::vector<int> &output){
+	if (file.records){
+		for (uint32_t i = 0; i < file.num_curves; i++){
+			if (overlap(file.records[i].box, box)) output.push_back(i);
+		}
+		return;
+	}
+	for (uint32_t i = 0; i < file.num_curves; i++){
+		AABB curve_box = { { file.x[0][i], file.x[0][i] }, { file.y[0][i], file.y[0][i] } };
+		for (int j = 1; j < 4; j++){
+			curve_box.x[0] = std::min(curve_box.x[0], file.x[j][i]);
+			curve_box.x[1] = std::max(curve_box.x[1], file.x[j][i]);
+			curve_box.y[0] = std::min(curve_box.y[0], file.y[j][i]);
+			curve_box.y[1] = std::max(curve_box.y[1], file.y[j][i]);
+		}
+		if (overlap(curve_box, box)) output.push_back(i);
+	}
+}
@@ -0,0 +1,50 @@
+#ifndef _CURVE_FILE_H_
+#define _CURVE_FILE_H_
+
+#include <stdint.h>
+#include <vector>
+#include "stream.h"
+
+#define CURVE_FILE_MAGIC     0x5643425a  /* "ZBCV" */
+#define CURVE_FILE_VERSION   1
+#define CURVE_FILE_ALIGNMENT 64
+
+// Offsets are from the beginning of the file and aligned to CURVE_FILE_ALIGNMENT
+class CurveFileHeader {
+public:
+	uint32_t magic;
+	uint32_t version;
+	uint32_t num_curves;
+	uint32_t record_size;      /* sizeof(StreamRecord) if the file has biarc records, 0 otherwise */
+	uint64_t points_offset;    /* 8 arrays of num_curves REAL, x of control points 0 to 3 then y of 0 to 3 */
+	uint64_t records_offset;   /* num_curves StreamRecords, 0 if the file has none */
+};
+
+// Mapped file, arrays point into the mapping and stay valid until close_curve_file
+class CurveFile {
+public:
+	uint32_t num_curves = 0;
+	const REAL *x[4] = { nullptr, nullptr, nullptr, nullptr };
+	const REAL *y[4] = { nullptr, nullptr, nullptr, nullptr };
+	const StreamRecord *records = nullptr;   /* nullptr if the file has none */
+
+	void *data = nullptr;
+	size_t size = 0;
+};
+
+// Records are written if given, one per curve as computed by convert_curve
+bool write_curve_file(const char *path, const std::vector<CubicBezierCurve> &curves, const StreamRecord *records = nullptr);
+
+// Maps the file read only, returns false if it can not be mapped or the header or any block does not fit the file
+bool open_curve_file(const char *path, CurveFile &file);
+
+void close_curve_file(CurveFile &file);
+
+// Copies curve i out of the arrays
+CubicBezierCurve get_curve(const CurveFile &file, int i);
+
+// Appends the indices of the curves whose box overlaps box, reading the mapping in place: the record boxes if the
+// file has records, otherwise the control point boxes from the arrays. Nothing is copied out of the file
+void query_box(const CurveFile &file, const AABB &box, std::vector<int> &output);
+
+#endif /* _CURVE_FILE_H_ */
@@ -0,0 +1,287 @@
+#include "aabb.h"
+#include "biarc_approx.h"
+#include "utils.h"
+#include <GL/glut.h>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+// Functions that call OpenGL, linked by the viewer only
+
+#define RES 100
+
+REAL get_AABB(const CubicBezierCurve &seg, const Arc arc, AABB& box, bool isDraw){
+	REAL error;
+
+	glColor3ub(64, 192, 0);
+    box = get_arc_aabb(&arc);
+
+    error = arc_approx_error_bound(&arc, &seg);
+
+    if (isDraw){
+        if (arc.radius != arc.radius){
+            glBegin(GL_LINE_STRIP);
+            glVertex2f(arc.center[0], arc.center[1]);
+            glVertex2f(arc.begin, arc.end);
+            glEnd();
+        }
+        else {
+            glBegin(GL_LINE_STRIP);
+            for (int i = 0; i <= RES; i++)
+            {
+                Point pt;
+                const REAL t = (REAL)i / (REAL)RES;
+                const REAL angle = t * (arc.end - arc.begin) + arc.begin;
+                pt[0] = arc.center[0] + arc.radius * cos(angle);
+                pt[1] = arc.center[1] + arc.radius * sin(angle);
+                glVertex2f(pt[0], pt[1]);
+            }
+            glEnd();
+        }
+    }
+
+	return error;
+}
+
+void draw_AABB(const AABB &box){
+	glBegin(GL_LINE_STRIP);
+	glVertex2f(box.x[0], box.y[0]);
+	glVertex2f(box.x[0], box.y[1]);
+	glVertex2f(box.x[1], box.y[1]);
+	glVertex2f(box.x[1], box.y[0]);
+	glVertex2f(box.x[0], box.y[0]);
+	glEnd();
+}
+
+void draw_arc(const std::shared_ptr<Arc> &arc){
+	glColor3ub(255, 0, 0);
+	glLineWidth(10.0);
+	if (arc->is_line()){
+		glBegin(GL_LINE_STRIP);
+		glVertex2f(arc->center[0], arc->center[1]);
+		glVertex2f(arc->center[0] + arc->begin, arc->center[1] + arc->end);
+		glEnd();
+	}
+	else {
+		glBegin(GL_LINE_STRIP);
+		for (int i = 0; i <= 100; i++)
+		{
+			Point pt;
+			const REAL t = (REAL)i / (REAL)100;
+			const REAL angle = t * (arc->end - arc->begin) + arc->begin;
+			pt[0] = arc->center[0] + arc->radius * cos(angle);
+			pt[1] = arc->center[1] + arc->radius * sin(angle);
+			glVertex2f(pt[0], pt[1]);
+		}
+		glEnd();
+	}
+	glLineWidth(1.0);
+}
+
+REAL distance(const std::shared_ptr<Arc> &arc1, const std::shared_ptr<Arc> &arc2)
+{
+	REAL d = std::numeric_limits<REAL>::max();
+	if (!arc1->is_line()){
+		if (arc2->is_line()){
+			return distance(arc2, arc1);
+		}
+		// Two arcs
+		else {
+			// Intersection check
+			REAL center_d = distance(arc1->center, arc2->center);
+			if (center_d < arc1->radius + arc2->radius
+				&& center_d > std::abs(arc1->radius - arc2->radius)){
+
+				// Find two candidate points, check if arcs contains them in a range
+				REAL angle1c1, angle1c2;
+				REAL angle2c1, angle2c2;
+				Point tangent;
+				subtract_point(arc1->center, arc2->center, tangent);
+				REAL base_angle = atan2(tangent[1], tangent[0]);
+
+				// Law of Cosines
+				REAL offset_angle_1 = acos((arc1->radius * arc1->radius + center_d * center_d - arc2->radius * arc2->radius) / 2.0 / arc1->radius / center_d);
+				REAL offset_angle_2 = acos((arc2->radius * arc2->radius + center_d * center_d - arc1->radius * arc1->radius) / 2.0 / arc2->radius / center_d);
+
+				angle1c1 = base_angle - M_PI - offset_angle_1;
+				angle1c2 = base_angle - M_PI + offset_angle_1;
+				angle2c1 = base_angle + offset_angle_2 - 2 * M_PI;
+				angle2c2 = base_angle - offset_angle_2 - 2 * M_PI;
+
+				while (angle1c1 < arc1->begin) angle1c1 += 2 * M_PI;
+				while (angle1c2 < arc1->begin) angle1c2 += 2 * M_PI;
+				while (angle2c1 < arc2->begin) angle2c1 += 2 * M_PI;
+				while (angle2c2 < arc2->begin) angle2c2 += 2 * M_PI;
+
+				if ((angle1c1 < arc1->end && angle2c1 < arc2->end) ||
+					(angle1c2 < arc1->end && angle2c2 < arc2->end)){
+					draw_arc(arc1);
+					draw_arc(arc2);
+					return 0.0;
+				}
+			}
+
+			// Check endpoint of two arcs
+			Point arc1_e1 = { arc1->center[0] + arc1->radius * cos(arc1->begin), arc1->center[1] + arc1->radius * sin(arc1->begin) };
+			Point arc1_e2 = { arc1->center[0] + arc1->radius * cos(arc1->end), arc1->center[1] + arc1->radius * sin(arc1->end) };
+			Point arc2_e1 = { arc2->center[0] + arc2->radius * cos(arc2->begin), arc2->center[1] + arc2->radius * sin(arc2->begin) };
+			Point arc2_e2 = { arc2->center[0] + arc2->radius * cos(arc2->end), arc2->center[1] + arc2->radius * sin(arc2->end) };
+	
+			d = std::min(d, distance(arc1_e1, arc2_e1));
+			d = std::min(d, distance(arc1_e1, arc2_e2));
+			d = std::min(d, distance(arc1_e2, arc2_e1));
+			d = std::min(d, distance(arc1_e2, arc2_e2));
+
+			// Check an endpoint of an arc and an interior point of the other arc, on a line connected to center
+			Point da1e1, da1e2, da2e1, da2e2;
+			subtract_point(arc2->center, arc1_e1, da1e1);
+			subtract_point(arc2->center, arc1_e2, da1e2);
+			subtract_point(arc1->center, arc2_e1, da2e1);
+			subtract_point(arc1->center, arc2_e2, da2e2);
+
+			normalize(da1e1);
+			normalize(da1e2);
+			normalize(da2e1);
+			normalize(da2e2);
+
+			REAL angle11, angle12, angle21, angle22;
+			angle11 = std::atan2(da1e1[1], da1e1[0]);
+			angle12 = std::atan2(da1e2[1], da1e2[0]);
+			angle21 = std::atan2(da2e1[1], da2e1[0]);
+			angle22 = std::atan2(da2e2[1], da2e2[0]);
+
+			if (angle11 < arc2->begin) angle11 += 2 * M_PI;
+			if (angle12 < arc2->begin) angle12 += 2 * M_PI;
+			if (angle21 < arc1->begin) angle21 += 2 * M_PI;
+			if (angle22 < arc1->begin) angle22 += 2 * M_PI;
+			if (angle11 < arc2->end){
+				Point interior = { arc2->center[0] + arc2->radius * cos(angle11), arc2->center[1] + arc2->radius * sin(angle11) };
+				d = std::min(d, distance(interior, da1e1));
+			}
+			if (angle12 < arc2->end){
+				Point interior = { arc2->center[0] + arc2->radius * cos(angle12), arc2->center[1] + arc2->radius * sin(angle12) };
+				d = std::min(d, distance(interior, da1e2));
+			}
+			if (angle21 < arc1->end){
+				Point interior = { arc1->center[0] + arc1->radius * cos(angle21), arc1->center[1] + arc1->radius * sin(angle21) };
+				d = std::min(d, distance(interior, da2e1));
+			}
+			if (angle22 < arc1->end){
+				Point interior = { arc1->center[0] + arc1->radius * cos(angle22), arc1->center[1] + arc1->radius * sin(angle22) };
+				d = std::min(d, distance(interior, da2e2));
+			}
+
+			// Check two interior points on a line connecting two center points
+			Point dc;
+			subtract_point(arc1->center, arc2->center, dc);
+			normalize(dc);
+			REAL angle1 = std::atan2(-dc[1], -dc[0]);
+			REAL angle2 = std::atan2(dc[1], dc[0]);
+
+			if (angle1 < arc1->begin) angle1 += 2 * M_PI;
+			if (angle2 < arc2->begin) angle2 += 2 * M_PI;
+			if (angle1 < arc1->end && angle2 < arc2->end){
+				Point interior1 = { arc1->center[0] + arc1->radius * cos(angle1), arc1->center[1] + arc1->radius * sin(angle1) };
+				Point interior2 = { arc2->center[0] + arc2->radius * cos(angle2), arc2->center[1] + arc2->radius * sin(angle2) };
+				d = std::min(d, distance(interior1, interior2));
+			}
+
+			return d;
+		}
+	}
+	else {
+		Point p1;
+		p1[0] = arc1->begin;
+		p1[1] = arc1->end;
+
+		// An arc and a line
+		if (!arc2->is_line()){
+			Point &line_end = p1;
+			Point &line_begin = arc1->center;
+
+			// Intersection check
+			REAL cld = distance(arc2->center, line_begin, line_end);
+			if (cld < arc2->radius){
+				Point vec;
+				subtract_point(line_end, line_begin, vec);
+
+				Point vec_perp;
+				vec_perp[0] = -vec[1];
+				vec_perp[1] = vec[0];
+
+				Point vec_to_line;
+				subtract_point(arc2->center, line_begin, vec_to_line);
+				normalize(vec_to_line);
+				normalize(vec_perp);
+				
+				REAL vec_norm = norm(vec);
+				REAL dis = (vec_to_line[0] * vec_perp[0] + vec_to_line[1] * vec_perp[1]);
+				vec_perp[0] *= dis;
+				vec_perp[1] *= dis;
+
+				REAL angle = std::atan2(vec_perp[1], vec_perp[0]);
+				REAL offset_angle = std::acos(cld / arc2->radius);
+
+				REAL angle1 = angle - offset_angle, angle2 = angle + offset_angle - 2 * M_PI;
+				while (angle1 < arc2->begin) angle1 += 2 * M_PI;
+				while (angle2 < arc2->begin) angle2 += 2 * M_PI;
+
+				Point inter1 = { arc2->center[0] + arc2->radius * cos(angle1), arc2->center[1] + arc2->radius * sin(angle1) };
+				Point inter2 = { arc2->center[0] + arc2->radius * cos(angle2), arc2->center[1] + arc2->radius * sin(angle2) };
+				if ((angle1 < arc2->end && ((inter1[0] - line_begin[0]) * (inter1[0] - line_end[0]) < 0 || (inter1[1] - line_begin[1]) * (inter1[1] - line_end[1]) < 0)) ||
+					(angle2 < arc2->end && ((inter2[0] - line_begin[0]) * (inter2[0] - line_end[0]) < 0 || (inter2[1] - line_begin[1]) * (inter2[1] - line_end[1]) < 0))){
+					draw_arc(arc1);
+					draw_arc(arc2);
+					return 0;
+				}
+
+				return 0;
+			}
+			
+			// Endpoint of arc to line
+			Point arc2_e1 = { arc2->center[0] + arc2->radius * cos(arc2->begin), arc2->center[1] + arc2->radius * sin(arc2->begin) };
+			Point arc2_e2 = { arc2->center[0] + arc2->radius * cos(arc2->end), arc2->center[1] + arc2->radius * sin(arc2->end) };
+
+			REAL center_d = distance(arc2->center, line_begin, line_end);
+			
+			d = std::min(d, distance(arc2_e1, line_begin, line_end));
+			d = std::min(d, distance(arc2_e2, line_begin, line_end));
+
+			// Interior point of arc to line
+			Point vec;
+			subtract_point(line_end, line_begin, vec);
+
+			Point vec_perp;
+			vec_perp[0] = -vec[1];
+			vec_perp[1] = vec[0];
+
+			Point vec_to_line;
+			subtract_point(arc2->center, line_begin, vec_to_line);
+			
+			REAL vec_norm = norm(vec);
+			REAL dis = (vec_to_line[0] * vec_perp[0] + vec_to_line[1] * vec_perp[1]) > 0 ? 1.0 : -1.0;
+			REAL angle = atan2(dis * vec_perp[1], dis * vec_perp[0]);
+
+			if (angle < arc2->begin) angle += 2 * M_PI;
+			if (angle < arc2->end){
+				Point interior = { arc2->center[0] + dis * arc2->radius * vec_perp[0], arc2->center[1] + dis * arc2->radius * vec_perp[1] };
+				d = std::min(d, distance(interior, line_begin, line_end));
+			}
+
+			return d;
+		}
+		// Two lines
+		else {
+			Point p2;
+			p2[0] = arc2->begin;
+			p2[1] = arc2->end;
+
+			d = std::min(d, distance(arc1->center, arc2->center, p2));
+			d = std::min(d, distance(p1, arc2->center, p2));
+			d = std::min(d, distance(p2, arc1->center, p1));
+			d = std::min(d, distance(arc2->center, arc1->center, p1));
+
+			return d;
+		}
+	}
+}
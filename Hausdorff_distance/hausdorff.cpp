@@ -1,5 +1,7 @@
 #include "hausdorff.h"
 
+#define NUM_SAMPLES 10
+
 REAL sample_points_distance(const Point &p, const CubicBezierCurve &c, int num_samples){
 	REAL min_dist = std::numeric_limits<REAL>::max();
 	for (int i = 0; i < num_samples + 1; i++){
@@ -205,19 +207,42 @@ CubicBezierCurve subcurve_by_endpoint(const CubicBezierCurve &c, REAL t1, REAL t
 	return seg2;
 }
 
-REAL projection(const Point &p, const CubicBezierCurve &c){
+REAL projection(const Point &p, const CubicBezierCurve &c, SearchStats *stats){
+	PolynomialCurve poly;
+	to_polynomial(&c, &poly);
+	return projection(p, c, poly, stats);
+}
+
+REAL projection(const Point &p, const CubicBezierCurve &c, const PolynomialCurve &poly, SearchStats *stats){
 	std::priority_queue<min_pair, std::vector<min_pair>, std::greater<min_pair>> q;
+	if (stats) stats->reset();
 	
 	// Use bounding box for bound computation, use biarc for final computation
 	REAL lower_bound = distance_lower_bound(p, c);
 	Point middle;
-	evaluate(&c, 0.5, middle);
+	evaluate(&poly, 0.5, middle);
 	REAL upper_bound = distance(p, middle);
+	if (stats) stats->update_upper_bound();
 	REAL eps = 1e-5;
 
 	REAL globalt = 0.5;
 
+	// Closest point is often an endpoint, which is never a midpoint of the subdivision
+	REAL end_dist = distance(p, c.control_pts[0]);
+	if (end_dist < upper_bound){
+		upper_bound = end_dist;
+		globalt = 0.0;
+		if (stats) stats->update_upper_bound();
+	}
+	end_dist = distance(p, c.control_pts[3]);
+	if (end_dist < upper_bound){
+		upper_bound = end_dist;
+		globalt = 1.0;
+		if (stats) stats->update_upper_bound();
+	}
+
 	q.push(std::make_pair(lower_bound, std::make_pair(0.0, 1.0)));
+	if (stats) stats->push(q.size());
 	while (!q.empty()){
 		REAL curr_bound = q.top().first;
 		if (curr_bound > upper_bound){
@@ -227,13 +252,17 @@ REAL projection(const Point &p, const CubicBezierCurve &c){
 		auto t2 = q.top().second.second;
 		q.pop();
 		lower_bound = curr_bound;
-		
-		CubicBezierCurve curve = subcurve_by_endpoint(c, t1, t2);
+		if (stats) stats->pop(lower_bound, upper_bound, q.size(), t2 - t1);
 
+		// Interval is at the resolution of REAL and can not be halved further
+		if ((t1 + t2) / 2.0 <= t1 || (t1 + t2) / 2.0 >= t2) continue;
+		
+		// Halves come from the cached power basis, without subdividing c down to the interval
 		CubicBezierCurve curve1, curve2;
-		subdivide(&curve, &curve1, &curve2);
 		auto c1_interv = std::make_pair(t1, (t1 + t2)/2.0);
 		auto c2_interv = std::make_pair((t1 + t2)/2.0 , t2);
+		subcurve(&poly, c1_interv.first, c1_interv.second, &curve1);
+		subcurve(&poly, c2_interv.first, c2_interv.second, &curve2);
 		REAL c1_bound = distance_lower_bound(p, curve1);
         if (c1_bound < curr_bound) 
             c1_bound = curr_bound;
@@ -242,50 +271,140 @@ REAL projection(const Point &p, const CubicBezierCurve &c){
             c2_bound = curr_bound;
 
 		Point middle;
-		evaluate(&curve1, 0.5, middle);
+		if (stats) stats->leaf_tests += 2;
+		evaluate(&poly, (c1_interv.first + c1_interv.second) / 2.0, middle);
 		REAL local_bound = distance(p, middle);
 		if (upper_bound > local_bound) {
 			upper_bound = local_bound;
 			globalt = (c1_interv.first + c1_interv.second) / 2.0;
+			if (stats) stats->update_upper_bound();
 		}
-        evaluate(&curve2, 0.5, middle);
+        evaluate(&poly, (c2_interv.first + c2_interv.second) / 2.0, middle);
         local_bound = distance(p, middle);
         if (upper_bound > local_bound) {
             upper_bound = local_bound;
             globalt = (c2_interv.first + c2_interv.second) / 2.0;
+            if (stats) stats->update_upper_bound();
         }
 
-		if (upper_bound - lower_bound < eps) break;
+		// Gap is relative to the distance, REAL can not resolve an absolute eps on large coordinates
+		if (upper_bound - lower_bound < eps * std::max((REAL)1.0, upper_bound)) break;
 
 		if (c1_bound < upper_bound){
 			q.push(std::make_pair(c1_bound, c1_interv));
+			if (stats) stats->push(q.size());
         }
+		else if (stats) stats->pruned++;
 		if (c2_bound < upper_bound){
 			q.push(std::make_pair(c2_bound, c2_interv));
+			if (stats) stats->push(q.size());
         }
+		else if (stats) stats->pruned++;
 	}
-    printf("%f %f\n", lower_bound, upper_bound);
 
+	if (stats) stats->final_gap = upper_bound - lower_bound;
 	return globalt;
 }
 
-REAL sample_lower_bound(const CubicBezierCurve &c1, const CubicBezierCurve &c2, const int num_samples, Point &pt1, Point &pt2){
-	std::vector<REAL> pts1x, pts1y;
-	std::vector<REAL> pts2x, pts2y;
-	for (int i = 0; i <= num_samples; i++){
+// Real roots of a t^3 + b t^2 + c t + d, falls back to lower degrees if the leading coefficients vanish
+static int solve_cubic(double a, double b, double c, double d, double roots[3]){
+	const double scale = std::max(std::max(std::abs(a), std::abs(b)), std::max(std::abs(c), std::abs(d)));
+	if (scale == 0.0) return 0;
+	if (std::abs(a) <= 1e-12 * scale){
+		if (std::abs(b) <= 1e-12 * scale){
+			if (c == 0.0) return 0;
+			roots[0] = -d / c;
+			return 1;
+		}
+		const double disc = c * c - 4.0 * b * d;
+		if (disc < 0.0) return 0;
+		// Stable form of the quadratic formula
+		const double q = -0.5 * (c + (c >= 0.0 ? std::sqrt(disc) : -std::sqrt(disc)));
+		roots[0] = q / b;
+		if (q == 0.0) return 1;
+		roots[1] = d / q;
+		return 2;
+	}
+
+	// Depressed cubic x^3 + p x + q with t = x - b / 3a
+	const double B = b / a, C = c / a, D = d / a;
+	const double p = C - B * B / 3.0;
+	const double q = 2.0 * B * B * B / 27.0 - B * C / 3.0 + D;
+	const double shift = -B / 3.0;
+	const double disc = q * q / 4.0 + p * p * p / 27.0;
+	if (disc >= 0.0){
+		const double sq = std::sqrt(disc);
+		roots[0] = std::cbrt(-q / 2.0 + sq) + std::cbrt(-q / 2.0 - sq) + shift;
+		return 1;
+	}
+	const double r = 2.0 * std::sqrt(-p / 3.0);
+	const double phi = std::acos(std::max(-1.0, std::min(1.0, 3.0 * q / (p * r))));
+	for (int k = 0; k < 3; k++){
+		roots[k] = r * std::cos((phi - 2.0 * M_PI * k) / 3.0) + shift;
+	}
+	return 3;
+}
+
+REAL projection(const Point &p, const QuadraticBezierCurve &c){
+	// Curve is a t^2 + b t + P0, closest point is where (curve(t) - p) . curve'(t) = 0
+	double a[2], b[2], w[2];
+	for (int k = 0; k < 2; k++){
+		a[k] = (double)c.control_pts[0][k] - 2.0 * c.control_pts[1][k] + c.control_pts[2][k];
+		b[k] = 2.0 * ((double)c.control_pts[1][k] - c.control_pts[0][k]);
+		w[k] = (double)c.control_pts[0][k] - p[k];
+	}
+	double roots[3];
+	const int num_roots = solve_cubic(2.0 * (a[0] * a[0] + a[1] * a[1]), 3.0 * (a[0] * b[0] + a[1] * b[1]),
+		b[0] * b[0] + b[1] * b[1] + 2.0 * (a[0] * w[0] + a[1] * w[1]), b[0] * w[0] + b[1] * w[1], roots);
+
+	// Endpoints are candidates as well as the roots within [0, 1]
+	REAL best_t = 0.0;
+	REAL best_dist = distance(p, c.control_pts[0]);
+	REAL end_dist = distance(p, c.control_pts[2]);
+	if (end_dist < best_dist){
+		best_dist = end_dist;
+		best_t = 1.0;
+	}
+	for (int i = 0; i < num_roots; i++){
+		if (!(roots[i] > 0.0 && roots[i] < 1.0)) continue;
 		Point pt;
-		const REAL t = (REAL)i / (REAL)num_samples;
-		evaluate(&c1, t, pt);
-		pts1x.push_back(pt[0]);
-		pts1y.push_back(pt[1]);
+		evaluate(&c, roots[i], pt);
+		REAL dist = distance(p, pt);
+		if (dist < best_dist){
+			best_dist = dist;
+			best_t = roots[i];
+		}
 	}
+	return best_t;
+}
+
+REAL projection(const Point &p, const LineSegment &line){
+	Point d, v;
+	subtract_point(line.control_pts[1], line.control_pts[0], d);
+	subtract_point(p, line.control_pts[0], v);
+	const REAL length_sq = d[0] * d[0] + d[1] * d[1];
+	if (length_sq == 0.0) return 0.0;
+	return std::max((REAL)0.0, std::min((REAL)1.0, (v[0] * d[0] + v[1] * d[1]) / length_sq));
+}
+
+REAL sample_lower_bound(const CubicBezierCurve &c1, const CubicBezierCurve &c2, const int num_samples, Point &pt1, Point &pt2){
+	PolynomialCurve poly2;
+	to_polynomial(&c2, &poly2);
+	return sample_lower_bound(c1, c2, poly2, num_samples, pt1, pt2);
+}
+
+REAL sample_lower_bound(const CubicBezierCurve &c1, const CubicBezierCurve &c2, const PolynomialCurve &poly2, const int num_samples, Point &pt1, Point &pt2){
+	PolynomialCurve poly1;
+	to_polynomial(&c1, &poly1);
+	std::vector<REAL> pts1x(num_samples + 1), pts1y(num_samples + 1);
+	evaluate(&poly1, num_samples, pts1x.data(), pts1y.data());
 
 	REAL max_dist = 0.0;
 	for (int i = 0; i < pts1x.size(); i++){
 		Point pt = { pts1x[i], pts1y[i] };
-		REAL t = projection(pt, c2);
+		REAL t = projection(pt, c2, poly2);
 		Point proj;
-		evaluate(&c2, t, proj);
+		evaluate(&poly2, t, proj);
 		REAL dist = distance(pt, proj);
 		if (max_dist < dist){
             max_dist = dist;
@@ -295,4 +414,144 @@ REAL sample_lower_bound(const CubicBezierCurve &c1, const CubicBezierCurve &c2,
 	}
 
 	return max_dist;
-}
\ No newline at end of file
+}
+
+REAL hausdorff_distance(const CubicBezierCurve &curve1, const CubicBezierCurve &curve2, HausdorffResult &result, SearchStats *stats, const SearchBudget *budget){
+	std::priority_queue<max_pair> q;
+	if (stats) stats->reset();
+	auto begin = std::chrono::steady_clock::now();
+	long pops = 0;
+	result.budget_exhausted = false;
+	// Budget with no limits is the same as none
+	if (budget && budget->unlimited()) budget = nullptr;
+	
+	// Both curves are converted once, every projection of the search is onto one of them
+	PolynomialCurve poly1, poly2;
+	to_polynomial(&curve1, &poly1);
+	to_polynomial(&curve2, &poly2);
+
+	Point tmp_pt1, tmp_pt2, tmp_pt3, tmp_pt4;
+	REAL t1_lower_bound = sample_lower_bound(curve1, curve2, poly2, NUM_SAMPLES, tmp_pt1, tmp_pt2);
+	REAL t2_lower_bound = sample_lower_bound(curve2, curve1, poly1, NUM_SAMPLES, tmp_pt3, tmp_pt4);
+	REAL lower_bound = std::max(t1_lower_bound, t2_lower_bound);
+	REAL upper_bound = bezier_error_bound(&curve1, &curve2);
+	if (stats){
+		stats->update_lower_bound();
+		stats->update_upper_bound();
+	}
+	Point bound1, bound2;
+	if (t1_lower_bound > t2_lower_bound){
+		copy_point(tmp_pt1, bound1);
+		copy_point(tmp_pt2, bound2);
+	}
+	else{
+		copy_point(tmp_pt3, bound1);
+		copy_point(tmp_pt4, bound2);
+	}
+
+	// Bezier segment from tree1 will be marked with False, and bezier segment from tree2 will be marked with True
+	q.push(std::make_pair(upper_bound, std::make_pair(std::make_pair(0.0, 1.0), false)));
+	q.push(std::make_pair(upper_bound, std::make_pair(std::make_pair(0.0, 1.0), true)));
+	if (stats){
+		stats->push(1);
+		stats->push(2);
+	}
+
+	int last_update = 0;
+
+	while (!q.empty()){
+		// Entries pushed before the lower bound rose can be below it, then no interval is farther than it
+		REAL curr_bound = std::max(q.top().first, lower_bound);
+		// Gap is relative to the distance, like projection
+		if (curr_bound - lower_bound < PRECISION * std::max((REAL)1.0, curr_bound)){
+			upper_bound = curr_bound;
+			break;
+		}
+		if (upper_bound > curr_bound){
+			last_update = 0;
+			if (stats) stats->update_upper_bound();
+		}
+		else last_update += 1;
+		upper_bound = curr_bound;
+
+		// Search is stopped by the budget, without one when upper bound has not decreased for a while
+		if (budget && budget->exhausted(pops, begin)){
+			result.budget_exhausted = true;
+			break;
+		}
+		if (!budget && last_update > 100) break;
+
+		auto local_t = q.top().second.first;
+		const REAL t_middle = (local_t.first + local_t.second) / 2.0;
+		// Interval at the resolution of REAL can not be halved, its endpoints were sampled into the lower bound
+		if (t_middle <= local_t.first || t_middle >= local_t.second){
+			q.pop();
+			if (stats) stats->pruned++;
+			continue;
+		}
+		auto idx = q.top().second.second;
+		auto proj_target = idx ? curve1 : curve2;
+		const PolynomialCurve &proj_poly = idx ? poly1 : poly2;
+		auto local_curve = idx ? curve2 : curve1;
+		q.pop();
+		pops++;
+		if (stats){
+			stats->pop(lower_bound, upper_bound, q.size(), local_t.second - local_t.first);
+			stats->leaf_tests += 3;
+		}
+
+		CubicBezierCurve local_seg = subcurve_by_endpoint(local_curve, local_t.first, local_t.second);
+
+		CubicBezierCurve left_seg, right_seg;
+		subdivide(&local_seg, &left_seg, &right_seg);
+
+		// Add child nodes to priority queue, compute upperbound by projecting two end points to other bezier
+		REAL t1 = projection(left_seg.control_pts[0], proj_target, proj_poly);
+		REAL t2 = projection(left_seg.control_pts[3], proj_target, proj_poly);
+		REAL t3 = projection(right_seg.control_pts[3], proj_target, proj_poly);
+
+		CubicBezierCurve c1 = subcurve_by_endpoint(proj_target, std::min(t1, t2), std::max(t1, t2));
+		CubicBezierCurve c2 = subcurve_by_endpoint(proj_target, std::min(t2, t3), std::max(t3, t2));
+
+		REAL upper_bound_left = bezier_error_bound(&(left_seg), &c1);
+		upper_bound_left = std::min(upper_bound_left, curr_bound);
+		REAL upper_bound_right = bezier_error_bound(&(right_seg), &c2);
+		upper_bound_right = std::min(upper_bound_right, curr_bound);
+
+		Point sample1, sample2;
+		REAL lower_bound_left = sample_lower_bound(left_seg, proj_target, proj_poly, NUM_SAMPLES, sample1, sample2);
+		if (lower_bound < lower_bound_left) {
+			lower_bound = lower_bound_left;
+			if (stats) stats->update_lower_bound();
+			copy_point(sample1, bound1);
+			copy_point(sample2, bound2);
+		}
+		REAL lower_bound_right = sample_lower_bound(right_seg, proj_target, proj_poly, NUM_SAMPLES, sample1, sample2);
+		if (lower_bound < lower_bound_right) {
+			lower_bound = lower_bound_right;
+			if (stats) stats->update_lower_bound();
+			copy_point(sample1, bound1);
+			copy_point(sample2, bound2);
+		}
+
+		// Halves whose upper bound is below the lower bound can not raise the distance
+		if (upper_bound_left > lower_bound){
+			q.push(std::make_pair(upper_bound_left, std::make_pair(std::make_pair(local_t.first, t_middle), idx)));
+			if (stats) stats->push(q.size());
+		}
+		else if (stats) stats->pruned++;
+		if (upper_bound_right > lower_bound){
+			q.push(std::make_pair(upper_bound_right, std::make_pair(std::make_pair(t_middle, local_t.second), idx)));
+			if (stats) stats->push(q.size());
+		}
+		else if (stats) stats->pruned++;
+	}
+	if (q.empty()) upper_bound = lower_bound;
+	if (stats) stats->final_gap = upper_bound - lower_bound;
+
+	result.lower_bound = lower_bound;
+	result.upper_bound = upper_bound;
+	copy_point(bound1, result.point1);
+	copy_point(bound2, result.point2);
+	return (upper_bound + lower_bound) / 2.0;
+}
@@ -1,8 +1,12 @@
+#ifndef _HAUSDORFF_H_
+#define _HAUSDORFF_H_
+
 #include <queue>
 #include <limits>
 #include <bits/stdc++.h>
 #include "aabb.h"
 #include "biarc_approx.h"
+#include "search_stats.h"
 
 REAL sample_points_distance(const Point &p, const CubicBezierCurve &c, int num_samples);
 
@@ -14,6 +18,35 @@ CubicBezierCurve subcurve_by_endpoint(const CubicBezierCurve &c, REAL t1, REAL t
 
 typedef std::pair<REAL, std::pair<REAL, REAL>> min_pair;
 
-REAL projection(const Point &p, const CubicBezierCurve &c);
+REAL projection(const Point &p, const CubicBezierCurve &c, SearchStats *stats = nullptr);
+
+// Same as above with poly converted once from c by to_polynomial, for many projections onto the same curve
+REAL projection(const Point &p, const CubicBezierCurve &c, const PolynomialCurve &poly, SearchStats *stats = nullptr);
+
+// Closed form, the closest parameter of a quadratic is a root of a cubic polynomial
+REAL projection(const Point &p, const QuadraticBezierCurve &c);
+
+REAL projection(const Point &p, const LineSegment &line);
 
 REAL sample_lower_bound(const CubicBezierCurve &c1, const CubicBezierCurve &c2, const int num_samples, Point &pt1, Point &pt2);
+
+REAL sample_lower_bound(const CubicBezierCurve &c1, const CubicBezierCurve &c2, const PolynomialCurve &poly2, const int num_samples, Point &pt1, Point &pt2);
+
+class HausdorffResult {
+public:
+	REAL lower_bound;
+	REAL upper_bound;
+	Point point1;
+	Point point2;
+	bool budget_exhausted;   /* query was stopped by its budget before convergence */
+};
+
+typedef std::pair<REAL, std::pair<std::pair<REAL, REAL>, bool>> max_pair;
+
+// Branch and bound over the parameter intervals of both curves, returns the middle of [lower_bound, upper_bound].
+// Search stops when the gap is below PRECISION, intervals that can not be halved are dropped. Without a budget it
+// also stops after 100 pops without a better upper bound, with one the budget stops it instead
+REAL hausdorff_distance(const CubicBezierCurve &curve1, const CubicBezierCurve &curve2, HausdorffResult &result,
+	SearchStats *stats = nullptr, const SearchBudget *budget = nullptr);
+
+#endif /* _HAUSDORFF_H_ */
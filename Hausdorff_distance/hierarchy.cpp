@@ -0,0 +1,354 @@
+#include "hierarchy.h"
+#include "utils.h"
+#include "tree_search.h"
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+
+#define NUM_SAMPLES 10
+#define LOOP_SEPARATION 1e-3
+#define SPLIT_POWER 4
+
+void get_leaf_arcs(const CubicBezierCurve &seg, CubicBezierCurve segs[2], VectorArc arcs[2], REAL errors[2]){
+	subdivide(&seg, &segs[0], &segs[1]);
+
+	Point inflect;
+	get_biarc_inflect(&seg, inflect);
+	to_biarc(&seg, inflect, &arcs[0], &arcs[1]);
+
+	// Line from each endpoint to the inflection point
+	VectorArc lines[2];
+	set_line(&lines[0], seg.control_pts[0], inflect);
+	set_line(&lines[1], seg.control_pts[3], inflect);
+
+	// If error bound is smaller with line approximation, line is used instead of an arc
+	for (int i = 0; i < 2; i++){
+		errors[i] = arc_approx_error_bound(&arcs[i], &segs[i]);
+		REAL line_error = arc_approx_error_bound(&lines[i], &segs[i]);
+		if (line_error < errors[i]){
+			arcs[i] = lines[i];
+			errors[i] = line_error;
+		}
+	}
+}
+
+static void inflate(AABB &box, REAL offset){
+	box.x[0] -= offset;
+	box.x[1] += offset;
+	box.y[0] -= offset;
+	box.y[1] += offset;
+}
+
+void build_hierarchy(std::shared_ptr<Hierarchy> h, int power){
+	const CubicBezierCurve &seg = h->curve;
+
+	auto leftH = std::make_shared<Hierarchy>();
+	auto rightH = std::make_shared<Hierarchy>();
+	const REAL t_middle = (h->t[0] + h->t[1]) / 2.0;
+	leftH->t[0] = h->t[0];
+	leftH->t[1] = t_middle;
+	rightH->t[0] = t_middle;
+	rightH->t[1] = h->t[1];
+
+	// Straight segment, e.g. an elevated line, is covered exactly by lines without further subdivision
+	REAL deviation;
+	const bool straight = is_straight(&seg, deviation);
+	if (power == 0 || straight){
+		CubicBezierCurve segs[2];
+		VectorArc arcs[2];
+		REAL errors[2];
+		if (straight){
+			subdivide(&seg, &segs[0], &segs[1]);
+			set_line(&arcs[0], seg.control_pts[0], segs[0].control_pts[3]);
+			set_line(&arcs[1], segs[1].control_pts[0], seg.control_pts[3]);
+			errors[0] = errors[1] = deviation;
+		}
+		else get_leaf_arcs(seg, segs, arcs, errors);
+
+		leftH->curve = segs[0];
+		rightH->curve = segs[1];
+		AABB boxes[2];
+		get_arc_aabb(arcs, boxes, 2);
+		leftH->box = boxes[0];
+		rightH->box = boxes[1];
+		inflate(leftH->box, errors[0]);
+		inflate(rightH->box, errors[1]);
+		leftH->error = errors[0];
+		rightH->error = errors[1];
+		leftH->arc = std::make_shared<VectorArc>(arcs[0]);
+		rightH->arc = std::make_shared<VectorArc>(arcs[1]);
+	}
+	else {
+		subdivide(&seg, &leftH->curve, &rightH->curve);
+		build_hierarchy(leftH, power - 1);
+		build_hierarchy(rightH, power - 1);
+	}
+	h->box = combine(leftH->box, rightH->box);
+	h->left = leftH;
+	h->right = rightH;
+}
+
+// Nodes above the split level, the node at depth and index is the leaf of the root curve at that power. Straight
+// nodes, nodes at the end of power and nodes at the split level are left to build_hierarchy as subtrees
+static void build_top(std::shared_ptr<Hierarchy> h, const CubicBezierCurve &root, int depth, int index, int power,
+	std::vector<std::pair<std::shared_ptr<Hierarchy>, int>> &subtrees){
+	REAL deviation;
+	if (depth == SPLIT_POWER || power == 0 || is_straight(&h->curve, deviation)){
+		subtrees.push_back(std::make_pair(h, power));
+		return;
+	}
+	h->left = std::make_shared<Hierarchy>();
+	h->right = std::make_shared<Hierarchy>();
+	const REAL t_middle = (h->t[0] + h->t[1]) / 2.0;
+	h->left->t[0] = h->t[0];
+	h->left->t[1] = h->right->t[0] = t_middle;
+	h->right->t[1] = h->t[1];
+	get_leaf(&root, depth + 1, 2 * index, &h->left->curve);
+	get_leaf(&root, depth + 1, 2 * index + 1, &h->right->curve);
+	build_top(h->left, root, depth + 1, 2 * index, power - 1, subtrees);
+	build_top(h->right, root, depth + 1, 2 * index + 1, power - 1, subtrees);
+}
+
+// Boxes of the nodes above the subtrees. A subtree root above the split level is straight or at the end of power,
+// so its children are the leaves with arcs
+static void combine_top(std::shared_ptr<Hierarchy> h, int depth){
+	if (depth == SPLIT_POWER || h->left->arc != nullptr) return;
+	combine_top(h->left, depth + 1);
+	combine_top(h->right, depth + 1);
+	h->box = combine(h->left->box, h->right->box);
+}
+
+void build_hierarchy(std::shared_ptr<Hierarchy> h, int power, int num_threads){
+	std::vector<std::pair<std::shared_ptr<Hierarchy>, int>> subtrees;
+	const CubicBezierCurve root = h->curve;
+	build_top(h, root, 0, 0, power, subtrees);
+
+	if (num_threads <= 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+	num_threads = std::max(1, std::min(num_threads, (int)subtrees.size()));
+
+	// Threads take the next subtree from a shared counter
+	std::atomic<size_t> next(0);
+	auto work = [&](){
+		for (size_t i = next++; i < subtrees.size(); i = next++){
+			build_hierarchy(subtrees[i].first, subtrees[i].second);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int id = 1; id < num_threads; id++){
+		threads.push_back(std::thread(work));
+	}
+	work();
+	for (auto &thread: threads) thread.join();
+
+	combine_top(h, 0);
+}
+
+REAL sample_points_distance(const CubicBezierCurve &c1, const CubicBezierCurve &c2, int num_samples, Point &pt1, Point &pt2){
+	std::vector<REAL> pts1x, pts1y;
+	std::vector<REAL> pts2x, pts2y;
+	for (int i = 0; i <= num_samples; i++){
+		Point pt;
+		const REAL t = (REAL)i / (REAL)num_samples;
+		evaluate(&c1, t, pt);
+		pts1x.push_back(pt[0]);
+		pts1y.push_back(pt[1]);
+		evaluate(&c2, t, pt);
+		pts2x.push_back(pt[0]);
+		pts2y.push_back(pt[1]);
+	}
+
+	REAL min_dist = std::numeric_limits<REAL>::max();
+	for (int i = 0; i < pts1x.size(); i++){
+		for (int j = 0; j < pts2x.size(); j++){
+			Point sample1 = { pts1x[i], pts1y[i] };
+			Point sample2 = { pts2x[j], pts2y[j] };
+			const REAL dist = distance(sample1, sample2);
+			if (dist < min_dist){
+				min_dist = dist;
+				copy_point(sample1, pt1);
+				copy_point(sample2, pt2);
+			}
+		}
+	}
+
+	return min_dist;
+}
+
+REAL minimum_distance(std::shared_ptr<Hierarchy> tree1, std::shared_ptr<Hierarchy> tree2, MinDistanceResult &result, SearchStats *stats, const SearchBudget *budget){
+	// Use bounding box for bound computation, use biarc for final computation
+	return tree_minimum_distance(tree1, tree2, NUM_SAMPLES, result, stats, budget,
+		[](const Hierarchy &node1, const Hierarchy &node2){ return distance(node1.box, node2.box); },
+		[](const Hierarchy &node){ return volume(node.box); },
+		[](const Hierarchy &node){ return diameter(node.box); });
+}
+
+void intersection(std::shared_ptr<Hierarchy> tree1, std::shared_ptr<Hierarchy> tree2, std::vector<curve_pair> &output){
+	if (!test_aabb_collision(tree1->box, tree2->box)) return;
+
+	// Break down larger AABB to child AABBs
+	if (tree1->left != nullptr && (tree2->left == nullptr || volume(tree1->box) > volume(tree2->box))){
+		intersection(tree1->left, tree2, output);
+		intersection(tree1->right, tree2, output);
+	}
+	else if (tree2->left != nullptr){
+		intersection(tree1, tree2->left, output);
+		intersection(tree1, tree2->right, output);
+	}
+	// Both hierarchy reached leaf
+	else {
+		output.push_back(std::make_pair(tree1->curve, tree2->curve));
+	}
+}
+
+void intersection(std::shared_ptr<Hierarchy> tree1, std::shared_ptr<Hierarchy> tree2, std::vector<node_pair> &output){
+	if (!test_aabb_collision(tree1->box, tree2->box)) return;
+
+	if (tree1->left != nullptr && (tree2->left == nullptr || volume(tree1->box) > volume(tree2->box))){
+		intersection(tree1->left, tree2, output);
+		intersection(tree1->right, tree2, output);
+	}
+	else if (tree2->left != nullptr){
+		intersection(tree1, tree2->left, output);
+		intersection(tree1, tree2->right, output);
+	}
+	else {
+		output.push_back(std::make_pair(tree1, tree2));
+	}
+}
+
+bool refine_intersection(const CubicBezierCurve &curve1, const CubicBezierCurve &curve2, REAL &t1, REAL &t2, Point &point){
+	for (int i = 0; i < NEWTON_ITERATIONS; i++){
+		Point p1, p2, d1, d2, f;
+		evaluate(&curve1, t1, p1);
+		evaluate(&curve2, t2, p2);
+		subtract_point(p1, p2, f);
+
+		// Tolerance follows the resolution of REAL at the coordinates
+		REAL tolerance = EPS * std::max((REAL)1.0, std::max(std::abs(p1[0]), std::abs(p1[1])));
+		if (norm(f) <= tolerance){
+			copy_point(p1, point);
+			return true;
+		}
+
+		evaluate_derivative(&curve1, t1, d1);
+		evaluate_derivative(&curve2, t2, d2);
+		// [d1, -d2] (dt1, dt2) = -f
+		REAL det = -d1[0] * d2[1] + d2[0] * d1[1];
+		if (std::abs(det) <= EPS * norm(d1) * norm(d2)) return false;
+		REAL dt1 = (f[0] * d2[1] - d2[0] * f[1]) / det;
+		REAL dt2 = (f[0] * d1[1] - d1[0] * f[1]) / det;
+		t1 = std::max((REAL)0.0, std::min((REAL)1.0, t1 + dt1));
+		t2 = std::max((REAL)0.0, std::min((REAL)1.0, t2 + dt2));
+	}
+	return false;
+}
+
+// True if every nonzero hodograph vector of the curves has a positive dot product with one direction,
+// then the curves are monotone along that direction and their union can not cross itself
+// At most two curves, so that the angles of their control polygon edges fit in the array
+static bool is_monotone(const CubicBezierCurve *curves, int num_curves){
+	std::array<REAL, 6> angles;
+	int n = 0;
+	for (int i = 0; i < num_curves; i++){
+		for (int j = 0; j < 3; j++){
+			Point d;
+			subtract_point(curves[i].control_pts[j + 1], curves[i].control_pts[j], d);
+			if (d[0] == 0.0 && d[1] == 0.0) continue;
+			angles[n++] = std::atan2(d[1], d[0]);
+		}
+	}
+	if (n == 0) return false;
+
+	// Insertion sort of at most 6 angles, std::sort on the fixed array trips -Warray-bounds in GCC
+	for (int i = 1; i < n; i++){
+		for (int j = i; j > 0 && angles[j] < angles[j - 1]; j--) std::swap(angles[j], angles[j - 1]);
+	}
+
+	// Vectors are within an open half plane if there is an angular gap wider than half circle
+	REAL max_gap = angles[0] + 2.0 * M_PI - angles[n - 1];
+	for (int i = 1; i < n; i++){
+		max_gap = std::max(max_gap, angles[i] - angles[i - 1]);
+	}
+	return max_gap > M_PI;
+}
+
+bool can_self_intersect(const CubicBezierCurve &curve){
+	return !is_monotone(&curve, 1);
+}
+
+// Pairs of leaves of the same tree that might cross each other, node1 is before node2 on the curve
+static void collect_self_pairs(std::shared_ptr<Hierarchy> node1, std::shared_ptr<Hierarchy> node2, std::vector<node_pair> &output){
+	if (node1 == node2){
+		if (!can_self_intersect(node1->curve)) return;
+		if (node1->left == nullptr){
+			output.push_back(std::make_pair(node1, node1));
+			return;
+		}
+		collect_self_pairs(node1->left, node1->left, output);
+		collect_self_pairs(node1->right, node1->right, output);
+		collect_self_pairs(node1->left, node1->right, output);
+		return;
+	}
+	if (!test_aabb_collision(node1->box, node2->box)) return;
+
+	// Adjacent nodes always touch at their shared endpoint
+	if (node1->t[1] == node2->t[0]){
+		CubicBezierCurve curves[2] = { node1->curve, node2->curve };
+		if (is_monotone(curves, 2)) return;
+	}
+
+	if (node1->left != nullptr && (node2->left == nullptr || volume(node1->box) > volume(node2->box))){
+		collect_self_pairs(node1->left, node2, output);
+		collect_self_pairs(node1->right, node2, output);
+	}
+	else if (node2->left != nullptr){
+		collect_self_pairs(node1, node2->left, output);
+		collect_self_pairs(node1, node2->right, output);
+	}
+	else {
+		output.push_back(std::make_pair(node1, node2));
+	}
+}
+
+void self_intersection(std::shared_ptr<Hierarchy> tree, std::vector<SelfIntersection> &output){
+	std::vector<node_pair> leaves;
+	collect_self_pairs(tree, tree, leaves);
+
+	REAL resolution = 1.0;
+	for (int i = 0; i < 4; i++){
+		resolution = std::max(resolution, std::max(std::abs(tree->curve.control_pts[i][0]), std::abs(tree->curve.control_pts[i][1])));
+	}
+	resolution *= EPS;
+
+	for (auto &leaf_pair: leaves){
+		const Hierarchy &leaf1 = *leaf_pair.first, &leaf2 = *leaf_pair.second;
+		SelfIntersection inter;
+		if (&leaf1 == &leaf2){
+			// Loop within a single leaf, started from its quarter points
+			inter.t1 = leaf1.t[0] + (leaf1.t[1] - leaf1.t[0]) / 4.0;
+			inter.t2 = leaf1.t[1] - (leaf1.t[1] - leaf1.t[0]) / 4.0;
+		}
+		else {
+			inter.t1 = (leaf1.t[0] + leaf1.t[1]) / 2.0;
+			inter.t2 = (leaf2.t[0] + leaf2.t[1]) / 2.0;
+		}
+		if (!refine_intersection(tree->curve, tree->curve, inter.t1, inter.t2, inter.point)) continue;
+		if (inter.t1 > inter.t2) std::swap(inter.t1, inter.t2);
+		// Newton iteration may fall onto the trivial solution t1 = t2
+		if (inter.t2 - inter.t1 <= LOOP_SEPARATION) continue;
+		// Loop within the evaluation error, which follows the magnitude of control points, can not be told from a cusp
+		Point middle, offset;
+		evaluate(&tree->curve, (inter.t1 + inter.t2) / 2.0, middle);
+		subtract_point(middle, inter.point, offset);
+		if (norm(offset) <= resolution) continue;
+
+		bool duplicate = false;
+		for (auto &other: output){
+			duplicate = duplicate || (std::abs(other.t1 - inter.t1) <= LOOP_SEPARATION && std::abs(other.t2 - inter.t2) <= LOOP_SEPARATION);
+		}
+		if (!duplicate) output.push_back(inter);
+	}
+}
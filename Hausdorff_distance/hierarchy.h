@@ -0,0 +1,69 @@
+#ifndef _HIERARCHY_H_
+#define _HIERARCHY_H_
+
+#include <vector>
+#include <utility>
+#include "aabb.h"
+#include "biarc_approx.h"
+#include "primitive_distance.h"
+#include "search_stats.h"
+
+#define NEWTON_ITERATIONS 16
+
+typedef std::pair<CubicBezierCurve, CubicBezierCurve> curve_pair;
+typedef std::pair<std::shared_ptr<Hierarchy>, std::shared_ptr<Hierarchy>> node_pair;
+
+class MinDistanceResult {
+public:
+	REAL lower_bound;
+	REAL upper_bound;
+	CubicBezierCurve curve1;
+	CubicBezierCurve curve2;
+	Point point1;
+	Point point2;
+	bool budget_exhausted;   /* query was stopped by its budget before convergence */
+};
+
+// Biarc (or line) approximation of both halves of a leaf segment, with the approximation error
+void get_leaf_arcs(const CubicBezierCurve &seg, CubicBezierCurve segs[2], VectorArc arcs[2], REAL errors[2]);
+
+void build_hierarchy(std::shared_ptr<Hierarchy> h, int power);
+
+// Same hierarchy as above, up to rounding of the node curves, built by num_threads threads (hardware concurrency
+// if 0). Nodes down to a fixed split level take their curves from get_leaf on the root curve instead of a chain of
+// subdivisions, the subtrees below them are built independently, so the result does not depend on the number of
+// threads
+void build_hierarchy(std::shared_ptr<Hierarchy> h, int power, int num_threads);
+
+REAL sample_points_distance(const CubicBezierCurve &c1, const CubicBezierCurve &c2, int num_samples, Point &pt1, Point &pt2);
+
+// Returns the middle of [lower_bound, upper_bound], with budget the query stops early and keeps the current interval
+REAL minimum_distance(std::shared_ptr<Hierarchy> tree1, std::shared_ptr<Hierarchy> tree2, MinDistanceResult &result,
+	SearchStats *stats = nullptr, const SearchBudget *budget = nullptr);
+
+void intersection(std::shared_ptr<Hierarchy> tree1, std::shared_ptr<Hierarchy> tree2, std::vector<curve_pair> &output);
+
+// Same as above, leaf nodes are reported to keep their arcs and parameter intervals
+void intersection(std::shared_ptr<Hierarchy> tree1, std::shared_ptr<Hierarchy> tree2, std::vector<node_pair> &output);
+
+class SelfIntersection {
+public:
+	REAL t1;   /* t1 < t2 */
+	REAL t2;
+	Point point;
+};
+
+// Solves curve1(t1) = curve2(t2) with Newton iteration from the given values,
+// fails if the Jacobian is singular or it does not converge
+bool refine_intersection(const CubicBezierCurve &curve1, const CubicBezierCurve &curve2, REAL &t1, REAL &t2, Point &point);
+
+// False if hodograph of the control polygon is within an open half plane, then the curve is monotone along
+// a direction and can not cross itself
+bool can_self_intersect(const CubicBezierCurve &curve);
+
+// Parameters where the curve of the tree crosses itself. Nodes that can not self intersect are skipped, pairs of
+// nodes are tested like intersection of two trees, and adjacent pairs are skipped if both are monotone along a
+// common direction. Each remaining leaf pair is refined with Newton iteration
+void self_intersection(std::shared_ptr<Hierarchy> tree, std::vector<SelfIntersection> &output);
+
+#endif /* _HIERARCHY_H_ */
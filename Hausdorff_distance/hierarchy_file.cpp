@@ -0,0 +1,147 @@
+#include "hierarchy_file.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FNV_OFFSET 14695981039346656037ull
+#define FNV_PRIME  1099511628211ull
+
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t size){
+	const unsigned char *bytes = (const unsigned char *)data;
+	for (size_t i = 0; i < size; i++){
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+uint64_t hierarchy_hash(const CubicBezierCurve &curve, const REAL t[2], int power){
+	const uint32_t version = HIERARCHY_FILE_VERSION;
+	const int32_t p = power;
+	uint64_t hash = fnv1a(FNV_OFFSET, curve.control_pts, sizeof(curve.control_pts));
+	hash = fnv1a(hash, t, 2 * sizeof(REAL));
+	hash = fnv1a(hash, &p, sizeof(p));
+	return fnv1a(hash, &version, sizeof(version));
+}
+
+static int flatten(std::shared_ptr<Hierarchy> node, std::vector<FlatNode> &nodes, std::vector<FlatLeaf> &leaves){
+	int index = nodes.size();
+	FlatNode flat;
+	memset(&flat, 0, sizeof(FlatNode));
+	flat.box = node->box;
+	flat.left = -1;
+	flat.right = leaves.size();
+	nodes.push_back(flat);
+
+	if (node->left){
+		int left = flatten(node->left, nodes, leaves);
+		int right = flatten(node->right, nodes, leaves);
+		nodes[index].left = left;
+		nodes[index].right = right;
+	}
+	else {
+		FlatLeaf leaf;
+		memset(&leaf, 0, sizeof(FlatLeaf));
+		leaf.arc = *node->arc;
+		leaf.error = node->error;
+		leaves.push_back(leaf);
+	}
+	return index;
+}
+
+void serialize_hierarchy(std::shared_ptr<Hierarchy> tree, int power, std::vector<char> &output){
+	std::vector<FlatNode> nodes;
+	std::vector<FlatLeaf> leaves;
+	flatten(tree, nodes, leaves);
+
+	HierarchyFileHeader header;
+	header.magic = HIERARCHY_FILE_MAGIC;
+	header.version = HIERARCHY_FILE_VERSION;
+	header.node_size = sizeof(FlatNode);
+	header.num_nodes = nodes.size();
+	header.leaf_size = sizeof(FlatLeaf);
+	header.num_leaves = leaves.size();
+	header.hash = hierarchy_hash(tree->curve, tree->t, power);
+
+	const size_t nodes_size = nodes.size() * sizeof(FlatNode);
+	output.resize(sizeof(HierarchyFileHeader) + nodes_size + leaves.size() * sizeof(FlatLeaf));
+	memcpy(output.data(), &header, sizeof(HierarchyFileHeader));
+	memcpy(output.data() + sizeof(HierarchyFileHeader), nodes.data(), nodes_size);
+	memcpy(output.data() + sizeof(HierarchyFileHeader) + nodes_size, leaves.data(), leaves.size() * sizeof(FlatLeaf));
+}
+
+// Records are copied one at a time, the blob need not be aligned for them
+static FlatNode read_node(const char *nodes, int index){
+	FlatNode flat;
+	memcpy(&flat, nodes + (size_t)index * sizeof(FlatNode), sizeof(FlatNode));
+	return flat;
+}
+
+// Curve and interval of node are set by its parent, children are split from them as in build_hierarchy
+static void unflatten(const char *nodes, const char *leaves, int index, Hierarchy &node){
+	const FlatNode flat = read_node(nodes, index);
+	node.box = flat.box;
+	node.left = node.right = nullptr;
+	node.arc = nullptr;
+	node.error = 0.0;
+	if (flat.left < 0){
+		FlatLeaf leaf;
+		memcpy(&leaf, leaves + (size_t)flat.right * sizeof(FlatLeaf), sizeof(FlatLeaf));
+		node.arc = std::make_shared<VectorArc>(leaf.arc);
+		node.error = leaf.error;
+		return;
+	}
+	node.left = std::make_shared<Hierarchy>();
+	node.right = std::make_shared<Hierarchy>();
+	subdivide(&node.curve, &node.left->curve, &node.right->curve);
+	const REAL t_middle = (node.t[0] + node.t[1]) / 2.0;
+	node.left->t[0] = node.t[0];
+	node.left->t[1] = node.right->t[0] = t_middle;
+	node.right->t[1] = node.t[1];
+	unflatten(nodes, leaves, flat.left, *node.left);
+	unflatten(nodes, leaves, flat.right, *node.right);
+}
+
+bool deserialize_hierarchy(const char *data, size_t size, std::shared_ptr<Hierarchy> tree, int power){
+	if (size < sizeof(HierarchyFileHeader)) return false;
+	HierarchyFileHeader header;
+	memcpy(&header, data, sizeof(HierarchyFileHeader));
+	// Counts are 32 bit and record sizes are checked first, so the expected size can not overflow
+	if (header.magic != HIERARCHY_FILE_MAGIC || header.version != HIERARCHY_FILE_VERSION || header.node_size != sizeof(FlatNode) ||
+		header.leaf_size != sizeof(FlatLeaf) || header.num_nodes == 0 || header.num_nodes > INT32_MAX ||
+		size != sizeof(HierarchyFileHeader) + (uint64_t)header.num_nodes * sizeof(FlatNode) + (uint64_t)header.num_leaves * sizeof(FlatLeaf)) return false;
+	if (header.hash != hierarchy_hash(tree->curve, tree->t, power)) return false;
+
+	// Children follow their parent in preorder, so that the indices can not form a cycle
+	const char *nodes = data + sizeof(HierarchyFileHeader);
+	const char *leaves = nodes + (size_t)header.num_nodes * sizeof(FlatNode);
+	const int num_nodes = header.num_nodes;
+	for (int i = 0; i < num_nodes; i++){
+		const FlatNode flat = read_node(nodes, i);
+		if (flat.left < 0 && (flat.right < 0 || (uint32_t)flat.right >= header.num_leaves)) return false;
+		if (flat.left >= 0 && (flat.left <= i || flat.right <= i || flat.left >= num_nodes || flat.right >= num_nodes)) return false;
+	}
+
+	unflatten(nodes, leaves, 0, *tree);
+	return true;
+}
+
+bool save_hierarchy(const char *path, std::shared_ptr<Hierarchy> tree, int power){
+	std::vector<char> blob;
+	serialize_hierarchy(tree, power, blob);
+	FILE *f = fopen(path, "wb");
+	if (f == nullptr) return false;
+	bool written = fwrite(blob.data(), 1, blob.size(), f) == blob.size();
+	return fclose(f) == 0 && written;
+}
+
+// File is read at once into a buffer of its size, which is deserialized in place
+bool load_hierarchy(const char *path, std::shared_ptr<Hierarchy> tree, int power){
+	FILE *f = fopen(path, "rb");
+	if (f == nullptr) return false;
+	long size = -1;
+	if (fseek(f, 0, SEEK_END) == 0) size = ftell(f);
+	std::vector<char> blob(size > 0 ? size : 0);
+	bool read = size > 0 && fseek(f, 0, SEEK_SET) == 0 && fread(blob.data(), 1, blob.size(), f) == blob.size();
+	fclose(f);
+	return read && deserialize_hierarchy(blob.data(), blob.size(), tree, power);
+}
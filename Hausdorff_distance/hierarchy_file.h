@@ -0,0 +1,53 @@
+#ifndef _HIERARCHY_FILE_H_
+#define _HIERARCHY_FILE_H_
+
+#include <stdint.h>
+#include <vector>
+#include "hierarchy.h"
+
+#define HIERARCHY_FILE_MAGIC     0x48564248  /* "HBVH" */
+#define HIERARCHY_FILE_VERSION   2
+
+// Header of the blob, followed by num_nodes FlatNodes in preorder, then num_leaves FlatLeaves
+class HierarchyFileHeader {
+public:
+	uint32_t magic;
+	uint32_t version;
+	uint32_t node_size;
+	uint32_t num_nodes;
+	uint32_t leaf_size;
+	uint32_t num_leaves;
+	uint64_t hash;   /* hierarchy_hash of the source it was built from */
+};
+
+// Node of the hierarchy with children as indices into the node array. A leaf has left -1 and right the index of
+// its FlatLeaf. Curves and intervals are not stored, they are recomputed on load by the same subdivisions
+// build_hierarchy makes from the root curve
+class FlatNode {
+public:
+	AABB box;
+	int32_t left;
+	int32_t right;
+};
+
+class FlatLeaf {
+public:
+	VectorArc arc;
+	REAL error;
+};
+
+// FNV-1a of the root control points, root interval, power and the format version
+uint64_t hierarchy_hash(const CubicBezierCurve &curve, const REAL t[2], int power);
+
+void serialize_hierarchy(std::shared_ptr<Hierarchy> tree, int power, std::vector<char> &output);
+
+// Source is the curve and interval already set in tree, the hierarchy is loaded only if the blob was built from
+// the same source with the same power. Returns false and leaves tree unchanged otherwise, or if the blob is malformed.
+// Nodes are read in place from data, curves of a tree built on threads come back up to rounding
+bool deserialize_hierarchy(const char *data, size_t size, std::shared_ptr<Hierarchy> tree, int power);
+
+bool save_hierarchy(const char *path, std::shared_ptr<Hierarchy> tree, int power);
+
+bool load_hierarchy(const char *path, std::shared_ptr<Hierarchy> tree, int power);
+
+#endif /* _HIERARCHY_FILE_H_ */
@@ -3,9 +3,9 @@
 #include <math.h>
 #include <random>
 #include "hausdorff.h"
+#include "curve_file.h"
 
 #define RES 100
-#define NUM_SAMPLES 10
 
 CubicBezierCurve curve1;
 CubicBezierCurve curve2;
@@ -17,6 +17,7 @@ int edit_curve_idx = -1;
 bool isDrawControlMesh = true;
 bool isDottedLine = false;
 bool isDrawBiarcs = false;
+bool isDrawStats = false;
 int subdivision_power = 6;
 int text_line = 0;
 int old_x, old_y;
@@ -75,12 +76,12 @@ void draw_curve(CubicBezierCurve& curve){
 		glBegin(GL_LINES);
 	else
 		glBegin(GL_LINE_STRIP);	
-	for (int i = 0; i <= RES; i++){
-		Point pt;
-		const REAL t = (REAL)i / (REAL)RES;
-		evaluate(&curve, t, pt);
-		glVertex2f(pt[0], pt[1]);
-	}
+	PolynomialCurve poly;
+	to_polynomial(&curve, &poly);
+	REAL xs[RES + 1], ys[RES + 1];
+	evaluate(&poly, RES, xs, ys);
+	for (int i = 0; i <= RES; i++)
+		glVertex2f(xs[i], ys[i]);
 	glEnd();
 }
 
@@ -106,84 +107,13 @@ void draw_text(std::string str){
 	text_line += 1;
 }
 
-typedef std::pair<REAL, std::pair<std::pair<REAL, REAL>, bool>> max_pair;
 void draw_hausdorff_distance(const CubicBezierCurve &curve1, const CubicBezierCurve &curve2){
-	std::priority_queue<max_pair> q;
-	
-	Point tmp_pt1, tmp_pt2, tmp_pt3, tmp_pt4;
-	REAL t1_lower_bound = sample_lower_bound(curve1, curve2, NUM_SAMPLES, tmp_pt1, tmp_pt2);
-	REAL t2_lower_bound = sample_lower_bound(curve2, curve1, NUM_SAMPLES, tmp_pt3, tmp_pt4);
-	REAL lower_bound = std::max(t1_lower_bound, t2_lower_bound);
-	REAL upper_bound = bezier_error_bound(&curve1, &curve2);
-	Point bound1, bound2;
-	if (t1_lower_bound > t2_lower_bound){
-		copy_point(tmp_pt1, bound1);
-		copy_point(tmp_pt2, bound2);
-	}
-	else{
-		copy_point(tmp_pt3, bound1);
-		copy_point(tmp_pt4, bound2);
-	}
-
-	// Bezier segment from tree1 will be marked with False, and bezier segment from tree2 will be marked with True
-	q.push(std::make_pair(upper_bound, std::make_pair(std::make_pair(0.0, 1.0), false)));
-	q.push(std::make_pair(upper_bound, std::make_pair(std::make_pair(0.0, 1.0), true)));
-
-	int last_update = 0;
-
-	while (!q.empty()){
-		REAL curr_bound = q.top().first;
-		if (curr_bound < lower_bound + 1e-5){
-			upper_bound = curr_bound;
-			break;
-		}
-		if (upper_bound > curr_bound) last_update = 0;
-		else last_update += 1;
-		if (last_update > 100) break;
-		upper_bound = curr_bound;
+	HausdorffResult result;
+	SearchStats stats;
+	hausdorff_distance(curve1, curve2, result, &stats);
+	REAL upper_bound = result.upper_bound, lower_bound = result.lower_bound;
+	const REAL *bound1 = result.point1, *bound2 = result.point2;
 
-		auto local_t = q.top().second.first;
-		auto idx = q.top().second.second;
-		auto proj_target = idx ? curve1 : curve2;
-		auto local_curve = idx ? curve2 : curve1;
-		q.pop();
-
-		CubicBezierCurve local_seg = subcurve_by_endpoint(local_curve, local_t.first, local_t.second);
-
-		CubicBezierCurve left_seg, right_seg;
-		subdivide(&local_seg, &left_seg, &right_seg);
-
-		// Add child nodes to priority queue, compute upperbound by projecting two end points to other bezier
-		REAL t1 = projection(left_seg.control_pts[0], proj_target);
-		REAL t2 = projection(left_seg.control_pts[3], proj_target);
-		REAL t3 = projection(right_seg.control_pts[3], proj_target);
-
-		CubicBezierCurve c1 = subcurve_by_endpoint(proj_target, std::min(t1, t2), std::max(t1, t2));
-		CubicBezierCurve c2 = subcurve_by_endpoint(proj_target, std::min(t2, t3), std::max(t3, t2));
-
-		REAL upper_bound_left = bezier_error_bound(&(left_seg), &c1);
-		upper_bound_left = std::min(upper_bound_left, curr_bound);
-		REAL upper_bound_right = bezier_error_bound(&(right_seg), &c2);
-		upper_bound_right = std::min(upper_bound_right, curr_bound);
-
-		Point sample1, sample2;
-		REAL lower_bound_left = sample_lower_bound(left_seg, proj_target, NUM_SAMPLES, sample1, sample2);
-		if (lower_bound < lower_bound_left) {
-			lower_bound = lower_bound_left;
-			copy_point(sample1, bound1);
-			copy_point(sample2, bound2);
-		}
-		REAL lower_bound_right = sample_lower_bound(right_seg, proj_target, NUM_SAMPLES, sample1, sample2);
-		if (lower_bound < lower_bound_right) {
-			lower_bound = lower_bound_right;
-			copy_point(sample1, bound1);
-			copy_point(sample2, bound2);
-		}
-
-		q.push(std::make_pair(upper_bound_left, std::make_pair(std::make_pair(local_t.first, (local_t.first + local_t.second) / 2.0), idx)));
-		q.push(std::make_pair(upper_bound_right, std::make_pair(std::make_pair((local_t.first + local_t.second) / 2.0, local_t.second), idx)));
-	}
-	
 	std::string distance = "Distance: " + std::to_string((upper_bound + lower_bound) / 2);
 	std::string error = "Error: " + std::to_string((upper_bound - lower_bound) / 2.0);
 	glColor3ub(255, 0, 0);
@@ -200,6 +130,7 @@ void draw_hausdorff_distance(const CubicBezierCurve &curve1, const CubicBezierCu
 	glLineWidth(1.0);
 	draw_text(distance);
 	draw_text(error);
+	draw_text(stats.to_string());
 }
 
 void display_callback()
@@ -234,16 +165,19 @@ void display_callback()
 	}
 	glEnd();
 
-	REAL t = projection(curve1.control_pts[0], curve2);
+	SearchStats proj_stats;
+	REAL t = projection(curve1.control_pts[0], curve2, &proj_stats);
 	Point proj;
 	evaluate(&curve2, t, proj);
 	glBegin(GL_LINES);
 	glVertex2f(curve1.control_pts[0][0], curve1.control_pts[0][1]);
 	glVertex2f(proj[0], proj[1]);
 	glEnd();
-	// draw_hausdorff_distance(curve1, curve2);
+	// Hausdorff query runs on every redraw, so it is drawn only with the statistics
+	if (isDrawStats) draw_hausdorff_distance(curve1, curve2);
 
 	draw_text("Magnification: " + std::to_string(1.0/mag));
+	if (isDrawStats) draw_text("Projection " + proj_stats.to_string());
 
 	/* control mesh */
 	if (isDrawControlMesh)
@@ -339,30 +273,35 @@ void mouse_move_callback(GLint x, GLint y)
 }
 
 void snapshot_points(){
-	std::ofstream fout("points.txt");
-	for (int i = 0; i < 4; i++){
-		fout << curve1.control_pts[i][0] << " " << curve1.control_pts[i][1] << std::endl;
+	std::vector<CubicBezierCurve> curves = { curve1, curve2 };
+	if (!write_curve_file("points.bin", curves)){
+		std::cout << "Failed to save points.\n";
 	}
-	for (int i = 0; i < 4; i++){
-		fout << curve2.control_pts[i][0] << " " << curve2.control_pts[i][1] << std::endl;
-	}
-	fout.close();
 }
 
+// Snapshots of older versions are text in points.txt
 void load_points(){
-	try{
-		std::ifstream fin("points.txt");
-		for (int i = 0; i < 4; i++){
-			fin >> curve1.control_pts[i][0] >> curve1.control_pts[i][1];
-		}
-		for (int i = 0; i < 4; i++){
-			fin >> curve2.control_pts[i][0] >> curve2.control_pts[i][1];
-		}
-		fin.close();
+	CurveFile file;
+	if (open_curve_file("points.bin", file) && file.num_curves >= 2){
+		curve1 = get_curve(file, 0);
+		curve2 = get_curve(file, 1);
+		close_curve_file(file);
+		return;
 	}
-	catch (...){
+	close_curve_file(file);
+
+	std::ifstream fin("points.txt");
+	if (!fin){
 		std::cout << "No points file found.\n";
+		return;
+	}
+	for (int i = 0; i < 4; i++){
+		fin >> curve1.control_pts[i][0] >> curve1.control_pts[i][1];
 	}
+	for (int i = 0; i < 4; i++){
+		fin >> curve2.control_pts[i][0] >> curve2.control_pts[i][1];
+	}
+	fin.close();
 }
 
 // void glutKeyboardFunc(void (*func)(unsigned char key, int x, int y));
@@ -379,6 +318,9 @@ void keyboard_callback(unsigned char key, int x, int y)
 	case 'c': case 'C':
 		isDrawControlMesh ^= true;
 		break;
+	case 'q': case 'Q':
+		isDrawStats ^= true;
+		break;
 	case '1':
 		snapshot_points();
 		break;
@@ -0,0 +1,245 @@
+#include "path.h"
+#include "utils.h"
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+#define INTERSECTION_TOLERANCE 1e-3
+
+int num_segments(const BezierPath &path){
+	if (path.coords.size() < 8) return 0;
+	return (path.coords.size() / 2 - 1) / 3;
+}
+
+CubicBezierCurve get_segment(const BezierPath &path, int i){
+	CubicBezierCurve curve;
+	for (int j = 0; j < 4; j++){
+		SET_PT2(curve.control_pts[j], path.coords[2 * (3 * i + j)], path.coords[2 * (3 * i + j) + 1]);
+	}
+	return curve;
+}
+
+void append_segment(BezierPath &path, const CubicBezierCurve &curve){
+	for (int j = path.coords.empty() ? 0 : 1; j < 4; j++){
+		path.coords.push_back(curve.control_pts[j][0]);
+		path.coords.push_back(curve.control_pts[j][1]);
+	}
+}
+
+void evaluate(const BezierPath &path, const REAL t, Point value){
+	int i = std::max(0, std::min(num_segments(path) - 1, (int)std::floor(t)));
+	CubicBezierCurve curve = get_segment(path, i);
+	evaluate(&curve, std::max((REAL)0.0, std::min((REAL)1.0, t - i)), value);
+}
+
+static std::shared_ptr<Hierarchy> build_path_node(const BezierPath &path, int begin, int end, int power){
+	auto node = std::make_shared<Hierarchy>();
+	node->t[0] = begin;
+	node->t[1] = end;
+	node->curve = get_segment(path, begin);
+	if (end - begin == 1){
+		build_hierarchy(node, power);
+		return node;
+	}
+
+	int middle = (begin + end) / 2;
+	node->left = build_path_node(path, begin, middle, power);
+	node->right = build_path_node(path, middle, end, power);
+	node->box = combine(node->left->box, node->right->box);
+	return node;
+}
+
+void build_hierarchy(std::shared_ptr<Hierarchy> h, const BezierPath &path, int power){
+	int n = num_segments(path);
+	if (n == 0) return;
+	auto root = build_path_node(path, 0, n, power);
+	*h = *root;
+}
+
+void intersection(std::shared_ptr<Hierarchy> tree1, std::shared_ptr<Hierarchy> tree2, std::vector<PathIntersection> &output){
+	std::vector<node_pair> leaves;
+	intersection(tree1, tree2, leaves);
+
+	const int begin = output.size();
+	for (auto &leaf_pair: leaves){
+		const Hierarchy &leaf1 = *leaf_pair.first, &leaf2 = *leaf_pair.second;
+		REAL u1 = 0.5, u2 = 0.5;
+		PathIntersection inter;
+		if (!refine_intersection(leaf1.curve, leaf2.curve, u1, u2, inter.point)) continue;
+		inter.t1 = leaf1.t[0] + u1 * (leaf1.t[1] - leaf1.t[0]);
+		inter.t2 = leaf2.t[0] + u2 * (leaf2.t[1] - leaf2.t[0]);
+
+		bool duplicate = false;
+		for (int i = begin; i < output.size(); i++){
+			duplicate = duplicate || (std::abs(output[i].t1 - inter.t1) <= INTERSECTION_TOLERANCE && std::abs(output[i].t2 - inter.t2) <= INTERSECTION_TOLERANCE);
+		}
+		if (!duplicate) output.push_back(inter);
+	}
+	std::sort(output.begin() + begin, output.end(), [](const PathIntersection &a, const PathIntersection &b){
+		return a.t1 < b.t1;
+	});
+}
+
+typedef std::pair<REAL, std::shared_ptr<Hierarchy>> min_node;
+REAL projection(const Point &p, std::shared_ptr<Hierarchy> tree){
+	std::priority_queue<min_node, std::vector<min_node>, std::greater<min_node>> q;
+	REAL upper_bound = std::numeric_limits<REAL>::max();
+	REAL globalt = tree->t[0];
+
+	Point pt;
+	SET_PT2(pt, p[0], p[1]);
+	AABB point_box = { { p[0], p[0] }, { p[1], p[1] } };
+	q.push(std::make_pair(distance(point_box, tree->box), tree));
+	while (!q.empty()){
+		if (q.top().first >= upper_bound) break;
+		auto node = q.top().second;
+		q.pop();
+
+		if (node->left == nullptr){
+			REAL t = projection(pt, node->curve);
+			Point closest;
+			evaluate(&node->curve, t, closest);
+			REAL dist = distance(pt, closest);
+			if (dist < upper_bound){
+				upper_bound = dist;
+				globalt = node->t[0] + t * (node->t[1] - node->t[0]);
+			}
+			continue;
+		}
+		q.push(std::make_pair(distance(point_box, node->left->box), node->left));
+		q.push(std::make_pair(distance(point_box, node->right->box), node->right));
+	}
+	return globalt;
+}
+
+// Node of one path in the Hausdorff search, below the leaves of the hierarchy it is a subcurve without a tree node
+class PathHausdorffNode {
+public:
+	REAL upper_bound;
+	std::shared_ptr<Hierarchy> node;
+	CubicBezierCurve curve;
+	REAL t[2];
+	bool idx;   /* false for a node of path1, true for path2 */
+
+	bool operator<(const PathHausdorffNode &other) const { return upper_bound < other.upper_bound; }
+};
+
+static AABB control_box(const CubicBezierCurve &curve){
+	AABB box = { { curve.control_pts[0][0], curve.control_pts[0][0] }, { curve.control_pts[0][1], curve.control_pts[0][1] } };
+	for (int i = 1; i < 4; i++){
+		box.x[0] = std::min(box.x[0], curve.control_pts[i][0]);
+		box.x[1] = std::max(box.x[1], curve.control_pts[i][0]);
+		box.y[0] = std::min(box.y[0], curve.control_pts[i][1]);
+		box.y[1] = std::max(box.y[1], curve.control_pts[i][1]);
+	}
+	return box;
+}
+
+// Distance of the middle point to the other path is the lower bound, upper bound adds the farthest corner of the box
+static REAL bound_node(PathHausdorffNode &n, const BezierPath &source, const BezierPath &target, std::shared_ptr<Hierarchy> target_tree, Point &pt1, Point &pt2){
+	evaluate(source, (n.t[0] + n.t[1]) / 2.0, pt1);
+	evaluate(target, projection(pt1, target_tree), pt2);
+	REAL dist = distance(pt1, pt2);
+
+	AABB box = n.node ? n.node->box : control_box(n.curve);
+	REAL farthest = 0.0;
+	for (int i = 0; i < 2; i++){
+		for (int j = 0; j < 2; j++){
+			Point corner = { box.x[i], box.y[j] };
+			farthest = std::max(farthest, distance(pt1, corner));
+		}
+	}
+	n.upper_bound = dist + farthest;
+	return dist;
+}
+
+REAL hausdorff_distance(const BezierPath &path1, std::shared_ptr<Hierarchy> tree1, const BezierPath &path2, std::shared_ptr<Hierarchy> tree2,
+	HausdorffResult &result, SearchStats *stats, const SearchBudget *budget){
+	std::priority_queue<PathHausdorffNode> q;
+	if (stats) stats->reset();
+	auto begin = std::chrono::steady_clock::now();
+	long pops = 0;
+	result.budget_exhausted = false;
+
+	REAL lower_bound = 0.0;
+	REAL upper_bound = std::numeric_limits<REAL>::max();
+	SET_PT2(result.point1, path1.coords[0], path1.coords[1]);
+	SET_PT2(result.point2, path1.coords[0], path1.coords[1]);
+
+	auto add_node = [&](PathHausdorffNode &n){
+		Point pt1, pt2;
+		REAL dist = n.idx ? bound_node(n, path2, path1, tree1, pt1, pt2) : bound_node(n, path1, path2, tree2, pt1, pt2);
+		if (stats) stats->leaf_tests++;
+		if (dist > lower_bound){
+			lower_bound = dist;
+			if (stats) stats->update_lower_bound();
+			copy_point(pt1, n.idx ? result.point2 : result.point1);
+			copy_point(pt2, n.idx ? result.point1 : result.point2);
+		}
+		if (n.upper_bound > lower_bound){
+			q.push(n);
+			if (stats) stats->push(q.size());
+		}
+		else if (stats) stats->pruned++;
+	};
+
+	for (int side = 0; side < 2; side++){
+		PathHausdorffNode root;
+		root.node = side ? tree2 : tree1;
+		root.curve = root.node->curve;
+		root.t[0] = root.node->t[0];
+		root.t[1] = root.node->t[1];
+		root.idx = side;
+		add_node(root);
+	}
+
+	while (!q.empty()){
+		REAL curr_bound = q.top().upper_bound;
+		if (curr_bound < upper_bound && stats) stats->update_upper_bound();
+		upper_bound = curr_bound;
+		// Gap is relative to the distance, like projection
+		if (upper_bound - lower_bound < PRECISION * std::max((REAL)1.0, upper_bound)) break;
+		if (budget && budget->exhausted(pops, begin)){
+			result.budget_exhausted = true;
+			break;
+		}
+
+		PathHausdorffNode n = q.top();
+		q.pop();
+		pops++;
+		if (stats) stats->pop(lower_bound, upper_bound, q.size(), n.t[1] - n.t[0]);
+
+		// Interval is at the resolution of REAL and can not be halved further
+		REAL t_middle = (n.t[0] + n.t[1]) / 2.0;
+		if (t_middle <= n.t[0] || t_middle >= n.t[1]) continue;
+
+		PathHausdorffNode children[2];
+		for (int i = 0; i < 2; i++){
+			children[i].idx = n.idx;
+			children[i].node = nullptr;
+		}
+		if (n.node && n.node->left){
+			children[0].node = n.node->left;
+			children[1].node = n.node->right;
+			for (int i = 0; i < 2; i++){
+				children[i].curve = children[i].node->curve;
+				children[i].t[0] = children[i].node->t[0];
+				children[i].t[1] = children[i].node->t[1];
+			}
+		}
+		else {
+			subdivide(&n.curve, &children[0].curve, &children[1].curve);
+			children[0].t[0] = n.t[0];
+			children[0].t[1] = children[1].t[0] = t_middle;
+			children[1].t[1] = n.t[1];
+		}
+		add_node(children[0]);
+		add_node(children[1]);
+	}
+	if (q.empty()) upper_bound = lower_bound;
+	if (stats) stats->final_gap = upper_bound - lower_bound;
+
+	result.lower_bound = lower_bound;
+	result.upper_bound = upper_bound;
+	return (upper_bound + lower_bound) / 2.0;
+}
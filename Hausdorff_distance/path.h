@@ -0,0 +1,49 @@
+#ifndef _PATH_H_
+#define _PATH_H_
+
+#include <vector>
+#include "hierarchy.h"
+#include "hausdorff.h"
+
+// Polybezier with 3 * n + 1 control points, segment i is control points 3i to 3i + 3 and shares its endpoints
+// with the neighboring segments. Path parameter t is in [0, n], segment i covers [i, i + 1]
+class BezierPath {
+public:
+	std::vector<REAL> coords;   /* x and y of each control point */
+};
+
+int num_segments(const BezierPath &path);
+
+CubicBezierCurve get_segment(const BezierPath &path, int i);
+
+// First segment adds all 4 control points, following segments start at the end of the path and add the last 3
+void append_segment(BezierPath &path, const CubicBezierCurve &curve);
+
+void evaluate(const BezierPath &path, const REAL t, Point value);
+
+// Hierarchy of every segment with given power below a balanced tree over the segments, node intervals are
+// path parameters. Inner node above the segments keeps the curve of its first segment, so that samples of
+// minimum_distance stay on the path. minimum_distance and intersection of hierarchy.h run on it as is
+void build_hierarchy(std::shared_ptr<Hierarchy> h, const BezierPath &path, int power);
+
+class PathIntersection {
+public:
+	REAL t1;   /* path parameters */
+	REAL t2;
+	Point point;
+};
+
+// Intersections of two paths, each overlapping leaf pair is refined with Newton iteration on its leaf curves
+// and duplicates at leaf and segment boundaries are merged. Output is sorted by t1
+void intersection(std::shared_ptr<Hierarchy> tree1, std::shared_ptr<Hierarchy> tree2, std::vector<PathIntersection> &output);
+
+// Closest point of the path to p, nodes are visited in order of box distance and leaves run projection
+// on their curve. Returns the path parameter
+REAL projection(const Point &p, std::shared_ptr<Hierarchy> tree);
+
+// Branch and bound over the nodes of both hierarchies, continued below the leaves by subdivision of their curves.
+// Node with distance d to the other path at its middle point q is bounded by [d, d + max |p - q|] over its box
+REAL hausdorff_distance(const BezierPath &path1, std::shared_ptr<Hierarchy> tree1, const BezierPath &path2, std::shared_ptr<Hierarchy> tree2,
+	HausdorffResult &result, SearchStats *stats = nullptr, const SearchBudget *budget = nullptr);
+
+#endif /* _PATH_H_ */
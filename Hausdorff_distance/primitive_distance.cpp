@@ -0,0 +1,245 @@
+#include "primitive_distance.h"
+#include "utils.h"
+#include <algorithm>
+#include <limits>
+
+static inline void update_witness(REAL d, const Point &q1, const Point &q2, REAL &best, Point &witness1, Point &witness2){
+	if (d < best){
+		best = d;
+		copy_point(q1, witness1);
+		copy_point(q2, witness2);
+	}
+}
+
+static inline REAL segment_witness(const Point &p, const Point &line_begin, const Point &line_end, Point &witness){
+	Point vec, vec_to_p;
+	subtract_point(line_end, line_begin, vec);
+	subtract_point(p, line_begin, vec_to_p);
+
+	REAL len_sq = vec[0] * vec[0] + vec[1] * vec[1];
+	REAL t = len_sq > 0.0 ? (vec_to_p[0] * vec[0] + vec_to_p[1] * vec[1]) / len_sq : 0.0;
+	t = std::max((REAL)0.0, std::min((REAL)1.0, t));
+
+	SET_VECTOR2(witness, line_begin[0] + t * vec[0], line_begin[1] + t * vec[1]);
+	return distance(p, witness);
+}
+
+static inline REAL arc_witness(const Point &p, const VectorArc &arc, Point &witness){
+	Point dir;
+	subtract_point(p, arc.center, dir);
+	REAL d = norm(dir);
+	if (d > 0.0 && arc.contains(dir)){
+		SET_VECTOR2(witness, arc.center[0] + dir[0] * arc.radius / d, arc.center[1] + dir[1] * arc.radius / d);
+		return std::abs(d - arc.radius);
+	}
+
+	REAL d_begin = distance(p, arc.begin);
+	REAL d_end = distance(p, arc.end);
+	if (d_begin < d_end){
+		copy_point(arc.begin, witness);
+		return d_begin;
+	}
+	copy_point(arc.end, witness);
+	return d_end;
+}
+
+REAL distance(const Point &p, const VectorArc &prim, Point &witness){
+	if (prim.kind == KIND_LINE) return segment_witness(p, prim.begin, prim.end, witness);
+	return arc_witness(p, prim, witness);
+}
+
+REAL distance(const Point &p, const VectorArc &prim){
+	Point witness;
+	return distance(p, prim, witness);
+}
+
+static bool segment_intersection(const Point &a1, const Point &a2, const Point &b1, const Point &b2, Point &inter){
+	Point da, db, d1, d2;
+	subtract_point(a2, a1, da);
+	subtract_point(b2, b1, db);
+	subtract_point(b1, a1, d1);
+	subtract_point(b2, a1, d2);
+	REAL s1 = da[0] * d1[1] - da[1] * d1[0];
+	REAL s2 = da[0] * d2[1] - da[1] * d2[0];
+	subtract_point(a1, b1, d1);
+	subtract_point(a2, b1, d2);
+	REAL s3 = db[0] * d1[1] - db[1] * d1[0];
+	REAL s4 = db[0] * d2[1] - db[1] * d2[0];
+	if (!(s1 * s2 < 0.0 && s3 * s4 < 0.0)) return false;
+
+	// s3, s4 are signed distances of a1, a2 to the other line
+	REAL t = s3 / (s3 - s4);
+	SET_VECTOR2(inter, a1[0] + t * da[0], a1[1] + t * da[1]);
+	return true;
+}
+
+static REAL distance_line_line(const VectorArc &line1, const VectorArc &line2, Point &witness1, Point &witness2){
+	Point inter;
+	if (segment_intersection(line1.begin, line1.end, line2.begin, line2.end, inter)){
+		copy_point(inter, witness1);
+		copy_point(inter, witness2);
+		return 0.0;
+	}
+
+	REAL d = std::numeric_limits<REAL>::max();
+	Point q;
+	update_witness(segment_witness(line1.begin, line2.begin, line2.end, q), line1.begin, q, d, witness1, witness2);
+	update_witness(segment_witness(line1.end, line2.begin, line2.end, q), line1.end, q, d, witness1, witness2);
+	update_witness(segment_witness(line2.begin, line1.begin, line1.end, q), q, line2.begin, d, witness1, witness2);
+	update_witness(segment_witness(line2.end, line1.begin, line1.end, q), q, line2.end, d, witness1, witness2);
+	return d;
+}
+
+static REAL distance_line_arc(const VectorArc &line, const VectorArc &arc, Point &witness1, Point &witness2){
+	REAL d = std::numeric_limits<REAL>::max();
+	Point q;
+	update_witness(arc_witness(line.begin, arc, q), line.begin, q, d, witness1, witness2);
+	update_witness(arc_witness(line.end, arc, q), line.end, q, d, witness1, witness2);
+	update_witness(segment_witness(arc.begin, line.begin, line.end, q), q, arc.begin, d, witness1, witness2);
+	update_witness(segment_witness(arc.end, line.begin, line.end, q), q, arc.end, d, witness1, witness2);
+
+	const Point &c = arc.center;
+	const REAL r = arc.radius;
+	Point vec, vec_to_c;
+	subtract_point(line.end, line.begin, vec);
+	subtract_point(c, line.begin, vec_to_c);
+	REAL len_sq = vec[0] * vec[0] + vec[1] * vec[1];
+	if (len_sq <= 0.0) return d;
+
+	// Intersection check, |begin + t * vec - c| = r
+	REAL b = -(vec[0] * vec_to_c[0] + vec[1] * vec_to_c[1]);
+	REAL cc = vec_to_c[0] * vec_to_c[0] + vec_to_c[1] * vec_to_c[1] - r * r;
+	REAL disc = b * b - len_sq * cc;
+	if (disc >= 0.0){
+		REAL sq = std::sqrt(disc);
+		REAL ts[2] = { (-b - sq) / len_sq, (-b + sq) / len_sq };
+		for (REAL t: ts){
+			if (t < 0.0 || t > 1.0) continue;
+			Point inter = { line.begin[0] + t * vec[0], line.begin[1] + t * vec[1] };
+			Point dir;
+			subtract_point(inter, c, dir);
+			if (arc.contains(dir)){
+				copy_point(inter, witness1);
+				copy_point(inter, witness2);
+				return 0.0;
+			}
+		}
+	}
+
+	// Interior point of arc to interior point of line, on the perpendicular through the center
+	REAL t = -b / len_sq;
+	if (t > 0.0 && t < 1.0){
+		Point foot = { line.begin[0] + t * vec[0], line.begin[1] + t * vec[1] };
+		Point dir;
+		subtract_point(foot, c, dir);
+		REAL foot_d = norm(dir);
+		if (foot_d > 0.0){
+			Point on_arc = { c[0] + dir[0] * r / foot_d, c[1] + dir[1] * r / foot_d };
+			if (arc.contains(dir)) update_witness(std::abs(foot_d - r), foot, on_arc, d, witness1, witness2);
+			Point opposite = { -dir[0], -dir[1] };
+			SET_VECTOR2(on_arc, c[0] - dir[0] * r / foot_d, c[1] - dir[1] * r / foot_d);
+			if (arc.contains(opposite)) update_witness(foot_d + r, foot, on_arc, d, witness1, witness2);
+		}
+	}
+
+	return d;
+}
+
+static REAL distance_arc_arc(const VectorArc &arc1, const VectorArc &arc2, Point &witness1, Point &witness2){
+	REAL d = std::numeric_limits<REAL>::max();
+	Point q;
+	update_witness(arc_witness(arc1.begin, arc2, q), arc1.begin, q, d, witness1, witness2);
+	update_witness(arc_witness(arc1.end, arc2, q), arc1.end, q, d, witness1, witness2);
+	update_witness(arc_witness(arc2.begin, arc1, q), q, arc2.begin, d, witness1, witness2);
+	update_witness(arc_witness(arc2.end, arc1, q), q, arc2.end, d, witness1, witness2);
+
+	Point dc;
+	subtract_point(arc2.center, arc1.center, dc);
+	REAL center_d = norm(dc);
+	if (center_d <= 0.0) return d;
+
+	const REAL r1 = arc1.radius, r2 = arc2.radius;
+	Point e = { dc[0] / center_d, dc[1] / center_d };
+
+	// Intersection check
+	if (center_d <= r1 + r2 && center_d >= std::abs(r1 - r2)){
+		REAL a = (r1 * r1 - r2 * r2 + center_d * center_d) / (2.0 * center_d);
+		REAL h = std::sqrt(std::max((REAL)0.0, r1 * r1 - a * a));
+		for (int s = -1; s <= 1; s += 2){
+			Point inter = { arc1.center[0] + a * e[0] - s * h * e[1], arc1.center[1] + a * e[1] + s * h * e[0] };
+			Point dir1, dir2;
+			subtract_point(inter, arc1.center, dir1);
+			subtract_point(inter, arc2.center, dir2);
+			if (arc1.contains(dir1) && arc2.contains(dir2)){
+				copy_point(inter, witness1);
+				copy_point(inter, witness2);
+				return 0.0;
+			}
+		}
+	}
+
+	// Two interior points on a line connecting two center points
+	for (int s1 = -1; s1 <= 1; s1 += 2){
+		for (int s2 = -1; s2 <= 1; s2 += 2){
+			Point dir1 = { s1 * e[0], s1 * e[1] };
+			Point dir2 = { s2 * e[0], s2 * e[1] };
+			if (!arc1.contains(dir1) || !arc2.contains(dir2)) continue;
+			Point p1 = { arc1.center[0] + r1 * dir1[0], arc1.center[1] + r1 * dir1[1] };
+			Point p2 = { arc2.center[0] + r2 * dir2[0], arc2.center[1] + r2 * dir2[1] };
+			update_witness(distance(p1, p2), p1, p2, d, witness1, witness2);
+		}
+	}
+
+	return d;
+}
+
+#define KIND_PAIR(K1, K2) (((K1) << 1) | (K2))
+
+// Dispatch on the pair of kinds, each kernel assumes its own kinds
+REAL distance(const VectorArc &prim1, const VectorArc &prim2, Point &witness1, Point &witness2){
+	switch (KIND_PAIR(prim1.kind, prim2.kind)){
+	case KIND_PAIR(KIND_ARC, KIND_ARC): return distance_arc_arc(prim1, prim2, witness1, witness2);
+	case KIND_PAIR(KIND_ARC, KIND_LINE): return distance_line_arc(prim2, prim1, witness2, witness1);
+	case KIND_PAIR(KIND_LINE, KIND_ARC): return distance_line_arc(prim1, prim2, witness1, witness2);
+	default: return distance_line_line(prim1, prim2, witness1, witness2);
+	}
+}
+
+REAL distance(const VectorArc &prim1, const VectorArc &prim2){
+	Point witness1, witness2;
+	return distance(prim1, prim2, witness1, witness2);
+}
+
+void distance(const VectorArc *prims1, const VectorArc *prims2, int num_pairs, REAL *output){
+	// Counting sort of pair indices by kinds, so that each kernel runs over a contiguous run of pairs
+	int offsets[5] = { 0, 0, 0, 0, 0 };
+	for (int i = 0; i < num_pairs; i++){
+		offsets[KIND_PAIR(prims1[i].kind, prims2[i].kind) + 1]++;
+	}
+	for (int k = 1; k < 5; k++){
+		offsets[k] += offsets[k - 1];
+	}
+	std::vector<int> order(num_pairs);
+	int ends[4] = { offsets[0], offsets[1], offsets[2], offsets[3] };
+	for (int i = 0; i < num_pairs; i++){
+		order[ends[KIND_PAIR(prims1[i].kind, prims2[i].kind)]++] = i;
+	}
+
+	Point witness1, witness2;
+	for (int j = offsets[KIND_PAIR(KIND_ARC, KIND_ARC)]; j < offsets[KIND_PAIR(KIND_ARC, KIND_ARC) + 1]; j++){
+		int i = order[j];
+		output[i] = distance_arc_arc(prims1[i], prims2[i], witness1, witness2);
+	}
+	for (int j = offsets[KIND_PAIR(KIND_ARC, KIND_LINE)]; j < offsets[KIND_PAIR(KIND_ARC, KIND_LINE) + 1]; j++){
+		int i = order[j];
+		output[i] = distance_line_arc(prims2[i], prims1[i], witness2, witness1);
+	}
+	for (int j = offsets[KIND_PAIR(KIND_LINE, KIND_ARC)]; j < offsets[KIND_PAIR(KIND_LINE, KIND_ARC) + 1]; j++){
+		int i = order[j];
+		output[i] = distance_line_arc(prims1[i], prims2[i], witness1, witness2);
+	}
+	for (int j = offsets[KIND_PAIR(KIND_LINE, KIND_LINE)]; j < offsets[KIND_PAIR(KIND_LINE, KIND_LINE) + 1]; j++){
+		int i = order[j];
+		output[i] = distance_line_line(prims1[i], prims2[i], witness1, witness2);
+	}
+}
@@ -0,0 +1,19 @@
+#ifndef _PRIMITIVE_DISTANCE_H_
+#define _PRIMITIVE_DISTANCE_H_
+
+#include "curve.h"
+
+// Distance between arcs and line segments, witness points are the closest points on each primitive
+
+REAL distance(const Point &p, const VectorArc &prim, Point &witness);
+
+REAL distance(const Point &p, const VectorArc &prim);
+
+REAL distance(const VectorArc &prim1, const VectorArc &prim2, Point &witness1, Point &witness2);
+
+REAL distance(const VectorArc &prim1, const VectorArc &prim2);
+
+// Distance of each pair (prims1[i], prims2[i]), pairs are processed grouped by their kinds
+void distance(const VectorArc *prims1, const VectorArc *prims2, int num_pairs, REAL *output);
+
+#endif /* _PRIMITIVE_DISTANCE_H_ */
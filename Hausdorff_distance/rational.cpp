@@ -0,0 +1,73 @@
+#include "rational.h"
+
+bool to_rational(const VectorArc *arc, RationalBezier<2> *output){
+	if (arc->is_line() || arc->major) return false;
+
+	Point u, v;
+	subtract_point(arc->begin, arc->center, u);
+	subtract_point(arc->end, arc->center, v);
+	const REAL r_sq = arc->radius * arc->radius;
+	// cos(sweep / 2) from cos(sweep) = u v / r^2, the tangents do not meet for half circle
+	const REAL cos_half = std::sqrt(std::max((REAL)0.0, (REAL)((r_sq + u[0] * v[0] + u[1] * v[1]) / (2.0 * r_sq))));
+	if (cos_half < EPS) return false;
+
+	// Intersection of two tangent lines lies on the bisector, at distance r / cos(sweep / 2) from the center
+	const REAL scale = 1.0 / (2.0 * cos_half * cos_half);
+	copy_point(arc->begin, output->control_pts[0]);
+	SET_PT2(output->control_pts[1], arc->center[0] + (u[0] + v[0]) * scale, arc->center[1] + (u[1] + v[1]) * scale);
+	copy_point(arc->end, output->control_pts[2]);
+	output->weights[0] = output->weights[2] = 1.0;
+	output->weights[1] = cos_half;
+	return true;
+}
+
+bool to_rational(const Arc *arc, RationalBezier<2> *output){
+	if (arc->is_line()) return false;
+	VectorArc vector_arc;
+	to_vector_arc(arc, &vector_arc);
+	return to_rational(&vector_arc, output);
+}
+
+// Factors C(3, i) C(2, j) / C(5, i + j) of the product of the Bernstein bases of degree 3 and 2
+static const REAL product_factors[4][3] = {
+	{ 1.0, 2.0 / 5.0, 1.0 / 10.0 },
+	{ 3.0 / 5.0, 6.0 / 10.0, 3.0 / 10.0 },
+	{ 3.0 / 10.0, 6.0 / 10.0, 3.0 / 5.0 },
+	{ 1.0 / 10.0, 2.0 / 5.0, 1.0 },
+};
+
+// Largest distance of the degree 5 control points, control point k collects the pairs i + j = k
+static REAL product_error_bound(const CubicBezierCurve *curve, const Point conic_pts[3], const REAL conic_weights[3]){
+	REAL bound_sq = 0.0;
+#pragma GCC unroll 6
+	for (int k = 0; k <= 5; k++){
+		REAL weight = 0.0, diff[2] = { 0.0, 0.0 };
+#pragma GCC unroll 4
+		for (int i = std::max(0, k - 2); i <= std::min(3, k); i++){
+			const int j = k - i;
+			const REAL factor = product_factors[i][j] * conic_weights[j];
+			weight += factor;
+			diff[0] += factor * (curve->control_pts[i][0] - conic_pts[j][0]);
+			diff[1] += factor * (curve->control_pts[i][1] - conic_pts[j][1]);
+		}
+		bound_sq = std::max(bound_sq, (diff[0] * diff[0] + diff[1] * diff[1]) / (weight * weight));
+	}
+	return std::sqrt(bound_sq);
+}
+
+REAL rational_error_bound(const CubicBezierCurve *curve, const RationalBezier<2> *conic){
+	// Orientation is the one that matches the endpoints, the bound of the other one is larger unless the
+	// curve is nearly closed
+	auto distance_sq = [](const Point p1, const Point p2){ return (p1[0] - p2[0]) * (p1[0] - p2[0]) + (p1[1] - p2[1]) * (p1[1] - p2[1]); };
+	const REAL forward = distance_sq(curve->control_pts[0], conic->control_pts[0]) + distance_sq(curve->control_pts[3], conic->control_pts[2]);
+	const REAL backward = distance_sq(curve->control_pts[0], conic->control_pts[2]) + distance_sq(curve->control_pts[3], conic->control_pts[0]);
+	if (forward <= backward) return product_error_bound(curve, conic->control_pts, conic->weights);
+
+	Point reversed_pts[3];
+	REAL reversed_weights[3];
+	for (int j = 0; j < 3; j++){
+		copy_point(conic->control_pts[2 - j], reversed_pts[j]);
+		reversed_weights[j] = conic->weights[2 - j];
+	}
+	return product_error_bound(curve, reversed_pts, reversed_weights);
+}
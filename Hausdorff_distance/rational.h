@@ -0,0 +1,141 @@
+#ifndef _RATIONAL_H_
+#define _RATIONAL_H_
+
+#include "bezier.h"
+
+// Rational Bezier curve of degree N, each point is the average of the control points weighted by the Bernstein
+// polynomials times weights. Conics and circular arcs are exact rational quadratics. With positive weights the
+// curve stays in the convex hull of its control points, kernels below assume positive weights
+template <int N, typename T = REAL>
+class RationalBezier {
+public:
+	T control_pts[N + 1][2];
+	T weights[N + 1];
+};
+
+// de Casteljau on the homogeneous control points (w x, w y, w)
+template <int N, typename T>
+constexpr void evaluate(const RationalBezier<N, T> *curve, const T t, T value[2]){
+	T pts[N + 1][3] = {};
+#pragma GCC unroll 16
+	for (int i = 0; i <= N; i++){
+		pts[i][0] = curve->weights[i] * curve->control_pts[i][0];
+		pts[i][1] = curve->weights[i] * curve->control_pts[i][1];
+		pts[i][2] = curve->weights[i];
+	}
+#pragma GCC unroll 16
+	for (int r = 1; r <= N; r++){
+#pragma GCC unroll 16
+		for (int i = 0; i <= N - r; i++){
+			for (int k = 0; k < 3; k++) pts[i][k] = (1 - t) * pts[i][k] + t * pts[i + 1][k];
+		}
+	}
+	value[0] = pts[0][0] / pts[0][2];
+	value[1] = pts[0][1] / pts[0][2];
+}
+
+// Quotient rule on the homogeneous curve (A, W), the derivative is (A' - value W') / W
+template <int N, typename T>
+constexpr void evaluate_derivative(const RationalBezier<N, T> *curve, const T t, T value[2]){
+	Bezier<N, T> numerator = {};
+	Bezier<N, T> weight = {};
+#pragma GCC unroll 16
+	for (int i = 0; i <= N; i++){
+		numerator.control_pts[i][0] = curve->weights[i] * curve->control_pts[i][0];
+		numerator.control_pts[i][1] = curve->weights[i] * curve->control_pts[i][1];
+		weight.control_pts[i][0] = weight.control_pts[i][1] = curve->weights[i];
+	}
+	T a[2], a_dt[2], w[2], w_dt[2];
+	evaluate(&numerator, t, a);
+	evaluate(&weight, t, w);
+	evaluate_derivative(&numerator, t, a_dt);
+	evaluate_derivative(&weight, t, w_dt);
+	value[0] = (a_dt[0] - a[0] / w[0] * w_dt[0]) / w[0];
+	value[1] = (a_dt[1] - a[1] / w[0] * w_dt[0]) / w[0];
+}
+
+// Splits at t on the homogeneous control points, out1 is the part over [0, t] and out2 over [t, 1]
+template <int N, typename T>
+constexpr void subdivide(const RationalBezier<N, T> *curve, const T t, RationalBezier<N, T> *out1, RationalBezier<N, T> *out2){
+	T pts[N + 1][3] = {};
+	T left[N + 1][3] = {}, right[N + 1][3] = {};
+#pragma GCC unroll 16
+	for (int i = 0; i <= N; i++){
+		pts[i][0] = curve->weights[i] * curve->control_pts[i][0];
+		pts[i][1] = curve->weights[i] * curve->control_pts[i][1];
+		pts[i][2] = curve->weights[i];
+	}
+	for (int k = 0; k < 3; k++){
+		left[0][k] = pts[0][k];
+		right[N][k] = pts[N][k];
+	}
+#pragma GCC unroll 16
+	for (int r = 1; r <= N; r++){
+#pragma GCC unroll 16
+		for (int i = 0; i <= N - r; i++){
+			for (int k = 0; k < 3; k++) pts[i][k] = (1 - t) * pts[i][k] + t * pts[i + 1][k];
+		}
+		for (int k = 0; k < 3; k++){
+			left[r][k] = pts[0][k];
+			right[N - r][k] = pts[N - r][k];
+		}
+	}
+#pragma GCC unroll 16
+	for (int i = 0; i <= N; i++){
+		out1->weights[i] = left[i][2];
+		out1->control_pts[i][0] = left[i][0] / left[i][2];
+		out1->control_pts[i][1] = left[i][1] / left[i][2];
+		out2->weights[i] = right[i][2];
+		out2->control_pts[i][0] = right[i][0] / right[i][2];
+		out2->control_pts[i][1] = right[i][1] / right[i][2];
+	}
+}
+
+// Exact degree elevation of the homogeneous control points
+template <int N, typename T>
+constexpr void elevate(const RationalBezier<N, T> *curve, RationalBezier<N + 1, T> *output){
+	output->weights[0] = curve->weights[0];
+	output->control_pts[0][0] = curve->control_pts[0][0];
+	output->control_pts[0][1] = curve->control_pts[0][1];
+#pragma GCC unroll 16
+	for (int i = 1; i <= N; i++){
+		const T a = (T)i / (N + 1);
+		const T w = a * curve->weights[i - 1] + (1 - a) * curve->weights[i];
+		output->weights[i] = w;
+		output->control_pts[i][0] = (a * curve->weights[i - 1] * curve->control_pts[i - 1][0] + (1 - a) * curve->weights[i] * curve->control_pts[i][0]) / w;
+		output->control_pts[i][1] = (a * curve->weights[i - 1] * curve->control_pts[i - 1][1] + (1 - a) * curve->weights[i] * curve->control_pts[i][1]) / w;
+	}
+	output->weights[N + 1] = curve->weights[N];
+	output->control_pts[N + 1][0] = curve->control_pts[N][0];
+	output->control_pts[N + 1][1] = curve->control_pts[N][1];
+}
+
+// Box of the control points, which contains the curve for positive weights
+template <int N, typename T>
+AABB get_curve_aabb(const RationalBezier<N, T> *curve){
+	AABB box;
+	box.x[0] = box.x[1] = curve->control_pts[0][0];
+	box.y[0] = box.y[1] = curve->control_pts[0][1];
+#pragma GCC unroll 16
+	for (int i = 1; i <= N; i++){
+		box.x[0] = std::min(box.x[0], (REAL)curve->control_pts[i][0]);
+		box.x[1] = std::max(box.x[1], (REAL)curve->control_pts[i][0]);
+		box.y[0] = std::min(box.y[0], (REAL)curve->control_pts[i][1]);
+		box.y[1] = std::max(box.y[1], (REAL)curve->control_pts[i][1]);
+	}
+	return box;
+}
+
+// Exact rational quadratic of an arc narrower than half circle, the middle control point is the intersection of
+// the end tangents and its weight is cos(sweep / 2). Returns false for a line or a wider arc
+bool to_rational(const VectorArc *arc, RationalBezier<2> *output);
+
+bool to_rational(const Arc *arc, RationalBezier<2> *output);
+
+// Bound of the distance between points of equal parameter on a cubic and a rational quadratic. Both are written
+// as degree 5 rational curves of the same weights, the cubic times the weight polynomial of the conic, so the
+// distance is at most the largest distance of the corresponding control points. The conic is also taken in
+// reverse if that matches the endpoints of the curve
+REAL rational_error_bound(const CubicBezierCurve *curve, const RationalBezier<2> *conic);
+
+#endif /* _RATIONAL_H_ */
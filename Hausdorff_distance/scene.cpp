@@ -0,0 +1,262 @@
+#include "scene.h"
+#include "utils.h"
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#define INTERSECTION_TOLERANCE 1e-3
+
+static std::shared_ptr<SceneNode> build_scene_node(const Scene &scene, std::vector<int> &indices, int begin, int end){
+	auto node = std::make_shared<SceneNode>();
+	node->box = scene.trees[indices[begin]]->box;
+	for (int i = begin + 1; i < end; i++){
+		node->box = combine(node->box, scene.trees[indices[i]]->box);
+	}
+	if (end - begin == 1){
+		node->curve_index = indices[begin];
+		return node;
+	}
+
+	// Median of box centers along the longer axis
+	int axis = node->box.x[1] - node->box.x[0] > node->box.y[1] - node->box.y[0] ? 0 : 1;
+	auto center = [&](int idx){
+		const AABB &box = scene.trees[idx]->box;
+		return axis == 0 ? box.x[0] + box.x[1] : box.y[0] + box.y[1];
+	};
+	int middle = (begin + end) / 2;
+	std::nth_element(indices.begin() + begin, indices.begin() + middle, indices.begin() + end,
+		[&](int a, int b){ return center(a) < center(b); });
+
+	node->left = build_scene_node(scene, indices, begin, middle);
+	node->right = build_scene_node(scene, indices, middle, end);
+	return node;
+}
+
+void build_scene(Scene &scene, const std::vector<CubicBezierCurve> &curves, int power){
+	scene.curves = curves;
+	scene.trees.clear();
+	for (auto &curve: curves){
+		auto tree = std::make_shared<Hierarchy>();
+		tree->curve = curve;
+		build_hierarchy(tree, power);
+		scene.trees.push_back(tree);
+	}
+
+	scene.root = nullptr;
+	if (curves.empty()) return;
+	std::vector<int> indices(curves.size());
+	for (int i = 0; i < indices.size(); i++) indices[i] = i;
+	scene.root = build_scene_node(scene, indices, 0, indices.size());
+}
+
+typedef std::pair<REAL, std::pair<std::shared_ptr<SceneNode>, std::shared_ptr<SceneNode>>> min_scene_pair;
+REAL minimum_distance(const Scene &scene, SceneDistanceResult &result){
+	result.index1 = result.index2 = -1;
+	if (scene.curves.size() < 2) return -1.0;
+
+	std::priority_queue<min_scene_pair, std::vector<min_scene_pair>, std::greater<min_scene_pair>> q;
+	REAL lower_bound = std::numeric_limits<REAL>::max();
+	REAL upper_bound = std::numeric_limits<REAL>::max();
+
+	// Pair of a node with itself stands for all pairs of different curves below the node
+	q.push(std::make_pair(0.0, std::make_pair(scene.root, scene.root)));
+	while (!q.empty()){
+		REAL curr_bound = q.top().first;
+		if (curr_bound >= upper_bound)
+			break;
+		auto node1 = q.top().second.first;
+		auto node2 = q.top().second.second;
+		q.pop();
+
+		if (node1 == node2){
+			if (node1->left == nullptr) continue;
+			q.push(std::make_pair(0.0, std::make_pair(node1->left, node1->left)));
+			q.push(std::make_pair(0.0, std::make_pair(node1->right, node1->right)));
+			q.push(std::make_pair(distance(node1->left->box, node1->right->box), std::make_pair(node1->left, node1->right)));
+			continue;
+		}
+
+		if (node1->left == nullptr && node2->left == nullptr){
+			// Both reached a curve, distance of the two curves is computed with their hierarchies
+			MinDistanceResult pair;
+			minimum_distance(scene.trees[node1->curve_index], scene.trees[node2->curve_index], pair);
+			lower_bound = std::min(lower_bound, pair.lower_bound);
+			if (pair.upper_bound < upper_bound){
+				upper_bound = pair.upper_bound;
+				result.index1 = node1->curve_index;
+				result.index2 = node2->curve_index;
+				result.pair = pair;
+			}
+			continue;
+		}
+
+		// Node with larger volume is divided
+		if (node1->left != nullptr && (node2->left == nullptr || volume(node1->box) > volume(node2->box))){
+			std::swap(node1, node2);
+		}
+		auto l_lower_bound = distance(node1->box, node2->left->box);
+		if (l_lower_bound < upper_bound){
+			q.push(std::make_pair(l_lower_bound, std::make_pair(node1, node2->left)));
+		}
+		auto r_lower_bound = distance(node1->box, node2->right->box);
+		if (r_lower_bound < upper_bound){
+			q.push(std::make_pair(r_lower_bound, std::make_pair(node1, node2->right)));
+		}
+	}
+
+	// Pairs left in the queue are farther than the closest pair
+	result.pair.lower_bound = std::min(lower_bound, upper_bound);
+	return (result.pair.upper_bound + result.pair.lower_bound) / 2.0;
+}
+
+static int find_group(std::vector<int> &parent, int i){
+	while (parent[i] != i){
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
+
+// Adds the intersection unless the same parameters are already in output from begin
+static void add_intersection(const SceneIntersection &inter, int begin, std::vector<SceneIntersection> &output){
+	for (int i = begin; i < output.size(); i++){
+		if (std::abs(output[i].t1 - inter.t1) <= INTERSECTION_TOLERANCE && std::abs(output[i].t2 - inter.t2) <= INTERSECTION_TOLERANCE) return;
+	}
+	output.push_back(inter);
+}
+
+void intersection(const Scene &scene, int index1, int index2, std::vector<SceneIntersection> &output){
+	std::vector<node_pair> leaves;
+	intersection(scene.trees[index1], scene.trees[index2], leaves);
+	if (leaves.empty()) return;
+	const int begin = output.size();
+
+	// Newton iteration from the middle of each leaf pair, kept if it converges within the intervals widened by their widths
+	std::vector<bool> refined(leaves.size(), false);
+	for (int i = 0; i < leaves.size(); i++){
+		const Hierarchy &leaf1 = *leaves[i].first, &leaf2 = *leaves[i].second;
+		SceneIntersection inter;
+		inter.index1 = index1;
+		inter.index2 = index2;
+		inter.t1 = (leaf1.t[0] + leaf1.t[1]) / 2.0;
+		inter.t2 = (leaf2.t[0] + leaf2.t[1]) / 2.0;
+		if (!refine_intersection(scene.curves[index1], scene.curves[index2], inter.t1, inter.t2, inter.point)) continue;
+
+		REAL width1 = leaf1.t[1] - leaf1.t[0], width2 = leaf2.t[1] - leaf2.t[0];
+		if (inter.t1 < leaf1.t[0] - width1 || inter.t1 > leaf1.t[1] + width1 ||
+			inter.t2 < leaf2.t[0] - width2 || inter.t2 > leaf2.t[1] + width2) continue;
+		refined[i] = true;
+		add_intersection(inter, begin, output);
+	}
+
+	// Leaf pairs are grouped if their intervals touch on both curves
+	std::vector<int> parent(leaves.size());
+	for (int i = 0; i < leaves.size(); i++) parent[i] = i;
+	for (int i = 0; i < leaves.size(); i++){
+		for (int j = i + 1; j < leaves.size(); j++){
+			const Hierarchy &a1 = *leaves[i].first, &a2 = *leaves[i].second;
+			const Hierarchy &b1 = *leaves[j].first, &b2 = *leaves[j].second;
+			if (a1.t[0] <= b1.t[1] && b1.t[0] <= a1.t[1] && a2.t[0] <= b2.t[1] && b2.t[0] <= a2.t[1]){
+				parent[find_group(parent, i)] = find_group(parent, j);
+			}
+		}
+	}
+	std::vector<bool> group_refined(leaves.size(), false);
+	for (int i = 0; i < leaves.size(); i++){
+		if (refined[i]) group_refined[find_group(parent, i)] = true;
+	}
+
+	// Group without converged leaf pair, e.g. tangent curves, is reported at its middle if two of its leaf arcs intersect
+	for (int g = 0; g < leaves.size(); g++){
+		if (find_group(parent, g) != g || group_refined[g]) continue;
+
+		REAL range1[2] = { 1.0, 0.0 }, range2[2] = { 1.0, 0.0 };
+		REAL arc_distance = std::numeric_limits<REAL>::max();
+		Point witness;
+		for (int i = 0; i < leaves.size(); i++){
+			if (find_group(parent, i) != g) continue;
+			const Hierarchy &leaf1 = *leaves[i].first, &leaf2 = *leaves[i].second;
+			range1[0] = std::min(range1[0], leaf1.t[0]);
+			range1[1] = std::max(range1[1], leaf1.t[1]);
+			range2[0] = std::min(range2[0], leaf2.t[0]);
+			range2[1] = std::max(range2[1], leaf2.t[1]);
+			Point witness1, witness2;
+			REAL d = distance(*leaf1.arc, *leaf2.arc, witness1, witness2);
+			if (d < arc_distance){
+				arc_distance = d;
+				copy_point(witness1, witness);
+			}
+		}
+		if (arc_distance > 0.0) continue;
+
+		SceneIntersection inter;
+		inter.index1 = index1;
+		inter.index2 = index2;
+		inter.t1 = (range1[0] + range1[1]) / 2.0;
+		inter.t2 = (range2[0] + range2[1]) / 2.0;
+		copy_point(witness, inter.point);
+		add_intersection(inter, begin, output);
+	}
+}
+
+// Pairs of different curves whose root boxes overlap, a node paired with itself stands for the pairs below it
+static void collect_pairs(std::shared_ptr<SceneNode> node1, std::shared_ptr<SceneNode> node2, std::vector<std::pair<int, int>> &pairs){
+	if (node1 == node2){
+		if (node1->left == nullptr) return;
+		collect_pairs(node1->left, node1->left, pairs);
+		collect_pairs(node1->right, node1->right, pairs);
+		collect_pairs(node1->left, node1->right, pairs);
+		return;
+	}
+	if (!test_aabb_collision(node1->box, node2->box)) return;
+
+	if (node1->left != nullptr && (node2->left == nullptr || volume(node1->box) > volume(node2->box))){
+		collect_pairs(node1->left, node2, pairs);
+		collect_pairs(node1->right, node2, pairs);
+	}
+	else if (node2->left != nullptr){
+		collect_pairs(node1, node2->left, pairs);
+		collect_pairs(node1, node2->right, pairs);
+	}
+	else {
+		pairs.push_back(std::make_pair(std::min(node1->curve_index, node2->curve_index), std::max(node1->curve_index, node2->curve_index)));
+	}
+}
+
+void intersection(const Scene &scene, std::vector<SceneIntersection> &output, int num_threads){
+	if (scene.root == nullptr) return;
+	const size_t first = output.size();
+	std::vector<std::pair<int, int>> pairs;
+	collect_pairs(scene.root, scene.root, pairs);
+
+	if (num_threads <= 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+	num_threads = std::max(1, std::min(num_threads, (int)pairs.size()));
+
+	// Threads take the next pair from a shared counter, each with its own output
+	std::atomic<size_t> next(0);
+	std::vector<std::vector<SceneIntersection>> outputs(num_threads);
+	auto work = [&](int id){
+		for (size_t i = next++; i < pairs.size(); i = next++){
+			intersection(scene, pairs[i].first, pairs[i].second, outputs[id]);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int id = 1; id < num_threads; id++){
+		threads.push_back(std::thread(work, id));
+	}
+	work(0);
+	for (auto &thread: threads) thread.join();
+
+	for (auto &local: outputs){
+		output.insert(output.end(), local.begin(), local.end());
+	}
+	// Entries the caller already had keep their place
+	std::sort(output.begin() + first, output.end(), [](const SceneIntersection &a, const SceneIntersection &b){
+		if (a.index1 != b.index1) return a.index1 < b.index1;
+		if (a.index2 != b.index2) return a.index2 < b.index2;
+		if (a.t1 != b.t1) return a.t1 < b.t1;
+		return a.t2 < b.t2;
+	});
+}
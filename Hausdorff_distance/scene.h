@@ -0,0 +1,57 @@
+#ifndef _SCENE_H_
+#define _SCENE_H_
+
+#include <vector>
+#include "hierarchy.h"
+
+// Node of the top level BVH over the curves of a scene, leaf holds the index of its curve
+class SceneNode {
+public:
+	AABB box;
+	int curve_index = -1;
+	std::shared_ptr<SceneNode> left = nullptr;
+	std::shared_ptr<SceneNode> right = nullptr;
+};
+
+// Curves with one hierarchy each, and a BVH over the root boxes of the hierarchies
+class Scene {
+public:
+	std::vector<CubicBezierCurve> curves;
+	std::vector<std::shared_ptr<Hierarchy>> trees;
+	std::shared_ptr<SceneNode> root = nullptr;
+};
+
+class SceneDistanceResult {
+public:
+	int index1;
+	int index2;
+	MinDistanceResult pair;   /* result of the closest pair, curve1 and curve2 are its leaf segments */
+};
+
+class SceneIntersection {
+public:
+	int index1;
+	int index2;
+	REAL t1;
+	REAL t2;
+	Point point;
+};
+
+// Builds the hierarchy of every curve with given power, and the top level BVH by median split along the longer axis
+void build_scene(Scene &scene, const std::vector<CubicBezierCurve> &curves, int power);
+
+// Closest pair of two different curves, node pairs of the top level BVH are visited in order of their box distance
+// and each pair of leaves runs minimum distance of the two hierarchies. Returns -1 with fewer than two curves
+REAL minimum_distance(const Scene &scene, SceneDistanceResult &result);
+
+// Intersections of two curves of the scene. Each pair of overlapping leaves of the hierarchies is refined with
+// Newton iteration from the middle of its intervals. Leaf pairs are grouped when their intervals touch on both curves,
+// a group where no Newton iteration converges is reported at its middle only if two of its leaf arcs intersect
+void intersection(const Scene &scene, int index1, int index2, std::vector<SceneIntersection> &output);
+
+// Intersections of every pair of curves, pairs with overlapping root boxes are found on the top level BVH and
+// split among num_threads threads (hardware concurrency if 0). Appended entries are sorted by curve indices and
+// parameters
+void intersection(const Scene &scene, std::vector<SceneIntersection> &output, int num_threads = 0);
+
+#endif /* _SCENE_H_ */
@@ -0,0 +1,93 @@
+#ifndef _SEARCH_STATS_H_
+#define _SEARCH_STATS_H_
+
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include "curve.h"
+#include "search_trace.h"
+
+// Counters of one branch and bound query, filled when a query is given a non-null stats pointer.
+// Leaf tests are the exact evaluations of a query: arc pair distances in the hierarchies,
+// point evaluations in projection and endpoint projections in the Hausdorff distance.
+// Pruned are the children discarded against the current bound instead of being pushed.
+// Each pop is written to trace if it is set, trace is kept on reset
+class SearchStats {
+public:
+	long pops;
+	long pushes;
+	long max_queue_size;
+	long leaf_tests;
+	long pruned;
+	long bound_updates;
+	double first_upper_bound_us;   /* -1 until the first upper bound is found */
+	REAL final_gap;
+	std::chrono::steady_clock::time_point begin;
+	SearchTrace *trace;
+
+	SearchStats(SearchTrace *trace = nullptr) : trace(trace){
+		clear();
+	}
+
+	// Called by the query on start
+	void reset(){
+		clear();
+		if (trace) trace->begin_query();
+	}
+
+	void pop(REAL lower_bound, REAL upper_bound, size_t queue_size, REAL width){
+		if (trace) trace->write(pops, lower_bound, upper_bound, queue_size, width);
+		pops++;
+	}
+
+	void push(size_t queue_size){
+		pushes++;
+		if ((long)queue_size > max_queue_size) max_queue_size = queue_size;
+	}
+
+	void update_upper_bound(){
+		bound_updates++;
+		if (first_upper_bound_us < 0.0)
+			first_upper_bound_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+	void update_lower_bound(){
+		bound_updates++;
+	}
+
+	std::string to_string() const {
+		char buf[256];
+		snprintf(buf, sizeof(buf), "pops %ld, pushes %ld, pruned %ld, max queue %ld, leaf tests %ld, bound updates %ld, first upper bound %.1fus, gap %g",
+			pops, pushes, pruned, max_queue_size, leaf_tests, bound_updates, first_upper_bound_us, final_gap);
+		return buf;
+	}
+
+private:
+	void clear(){
+		pops = pushes = max_queue_size = leaf_tests = pruned = bound_updates = 0;
+		first_upper_bound_us = -1.0;
+		final_gap = 0.0;
+		begin = std::chrono::steady_clock::now();
+	}
+};
+
+// Limits of an anytime query, zero is no limit. A query stopped by its budget returns the interval
+// and witnesses it has reached so far
+class SearchBudget {
+public:
+	long max_pops;
+	double time_limit_us;
+
+	SearchBudget(long max_pops = 0, double time_limit_us = 0.0) : max_pops(max_pops), time_limit_us(time_limit_us){}
+
+	// Budget without limits, queries treat it as no budget
+	bool unlimited() const { return max_pops <= 0 && time_limit_us <= 0.0; }
+
+	bool exhausted(long pops, std::chrono::steady_clock::time_point begin) const {
+		if (max_pops > 0 && pops >= max_pops) return true;
+		return time_limit_us > 0.0 &&
+			std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() >= time_limit_us;
+	}
+};
+
+#endif /* _SEARCH_STATS_H_ */
@@ -0,0 +1,43 @@
+#include "search_trace.h"
+
+// Query number is incremented on start, so that the first query is zero
+SearchTrace::SearchTrace(FILE *output, TraceFormat format) : output(output), format(format), query((uint32_t)-1){
+	if (format == TRACE_CSV){
+		fprintf(output, "query,iteration,lower_bound,upper_bound,queue_size,width\n");
+	}
+	else {
+		uint32_t header[3] = { TRACE_MAGIC, TRACE_VERSION, sizeof(TraceRecord) };
+		fwrite(header, sizeof(uint32_t), 3, output);
+	}
+}
+
+void SearchTrace::begin_query(){
+	query++;
+}
+
+void SearchTrace::write(uint32_t iteration, REAL lower_bound, REAL upper_bound, size_t queue_size, REAL width){
+	if (format == TRACE_CSV){
+		fprintf(output, "%u,%u,%.9g,%.9g,%zu,%.9g\n", query, iteration, lower_bound, upper_bound, queue_size, width);
+		return;
+	}
+	TraceRecord record;
+	record.query = query;
+	record.iteration = iteration;
+	record.queue_size = (uint32_t)queue_size;
+	record.lower_bound = lower_bound;
+	record.upper_bound = upper_bound;
+	record.width = width;
+	fwrite(&record, sizeof(TraceRecord), 1, output);
+}
+
+bool read_trace(FILE *input, std::vector<TraceRecord> &output){
+	uint32_t header[3];
+	if (fread(header, sizeof(uint32_t), 3, input) != 3) return false;
+	if (header[0] != TRACE_MAGIC || header[1] != TRACE_VERSION || header[2] != sizeof(TraceRecord)) return false;
+
+	TraceRecord record;
+	while (fread(&record, sizeof(TraceRecord), 1, input) == 1){
+		output.push_back(record);
+	}
+	return true;
+}
@@ -0,0 +1,48 @@
+#ifndef _SEARCH_TRACE_H_
+#define _SEARCH_TRACE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include "curve.h"
+
+#define TRACE_MAGIC     0x52544242  /* "BBTR" */
+#define TRACE_VERSION   1
+
+enum TraceFormat {
+	TRACE_CSV = 0,
+	TRACE_BINARY
+};
+
+// One popped node of a branch and bound query. Width is the parameter interval of the node in projection and
+// Hausdorff distance, and the larger bounding volume diameter of the node pair in the hierarchies
+class TraceRecord {
+public:
+	uint32_t query;
+	uint32_t iteration;
+	uint32_t queue_size;
+	float lower_bound;
+	float upper_bound;
+	float width;
+};
+
+// Binary stream is a header of magic, version and record size as uint32_t, followed by raw TraceRecords
+class SearchTrace {
+public:
+	SearchTrace(FILE *output, TraceFormat format);
+
+	// Called by the query on start, records of each query are numbered from zero
+	void begin_query();
+
+	void write(uint32_t iteration, REAL lower_bound, REAL upper_bound, size_t queue_size, REAL width);
+
+private:
+	FILE *output;
+	TraceFormat format;
+	uint32_t query;
+};
+
+// Reads a binary trace, returns false if the header does not match
+bool read_trace(FILE *input, std::vector<TraceRecord> &output);
+
+#endif /* _SEARCH_TRACE_H_ */
@@ -0,0 +1,166 @@
+#include "stream.h"
+#include "text_import.h"
+#include <string.h>
+#include <ctype.h>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+// Queue between two stages of the pipeline, push blocks while it holds capacity items
+template <typename T>
+class BoundedQueue {
+public:
+	BoundedQueue(int capacity) : capacity(capacity) {}
+
+	void push(T &&item){
+		std::unique_lock<std::mutex> lock(mutex);
+		not_full.wait(lock, [&]{ return (int)items.size() < capacity; });
+		items.push_back(std::move(item));
+		not_empty.notify_one();
+	}
+
+	// Returns false once the queue is closed and empty
+	bool pop(T &item){
+		std::unique_lock<std::mutex> lock(mutex);
+		not_empty.wait(lock, [&]{ return !items.empty() || closed; });
+		if (items.empty()) return false;
+		item = std::move(items.front());
+		items.pop_front();
+		not_full.notify_one();
+		return true;
+	}
+
+	void close(){
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+		not_empty.notify_all();
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable not_full, not_empty;
+	std::deque<T> items;
+	int capacity;
+	bool closed = false;
+};
+
+void convert_curve(const CubicBezierCurve &curve, StreamRecord &record){
+	CubicBezierCurve segs[2];
+	get_leaf_arcs(curve, segs, record.arcs, record.errors);
+
+	AABB boxes[2];
+	get_arc_aabb(record.arcs, boxes, 2);
+	for (int i = 0; i < 2; i++){
+		boxes[i].x[0] -= record.errors[i];
+		boxes[i].x[1] += record.errors[i];
+		boxes[i].y[0] -= record.errors[i];
+		boxes[i].y[1] += record.errors[i];
+	}
+	record.box = combine(boxes[0], boxes[1]);
+}
+
+void write_record(FILE *output, const StreamRecord &record){
+	for (int i = 0; i < 2; i++){
+		const VectorArc &arc = record.arcs[i];
+		fprintf(output, "%d %.9g %.9g %.9g %.9g %.9g %.9g %.9g %d ", (int)arc.kind, arc.center[0], arc.center[1], arc.radius,
+			arc.begin[0], arc.begin[1], arc.end[0], arc.end[1], (int)arc.major);
+	}
+	fprintf(output, "%.9g %.9g %.9g %.9g %.9g %.9g\n", record.errors[0], record.errors[1],
+		record.box.x[0], record.box.x[1], record.box.y[0], record.box.y[1]);
+}
+
+// Parses numbers of a chunk, numbers of an unfinished curve are kept in pending for the next chunk
+static bool parse_chunk(const char *begin, const char *end, REAL pending[8], int &num_pending, std::vector<CubicBezierCurve> &batch){
+	const char *p = begin;
+	while (true){
+		while (p < end && isspace((unsigned char)*p)) p++;
+		if (p == end) return true;
+		REAL value;
+		if (!parse_real(p, end, value) || (p < end && !isspace((unsigned char)*p))) return false;
+
+		pending[num_pending++] = value;
+		if (num_pending == 8){
+			CubicBezierCurve curve;
+			for (int i = 0; i < 4; i++) SET_PT2(curve.control_pts[i], pending[2 * i], pending[2 * i + 1]);
+			batch.push_back(curve);
+			num_pending = 0;
+		}
+	}
+}
+
+bool process_stream(FILE *input, FILE *output, StreamStats &stats, size_t chunk_size, int queue_capacity){
+	BoundedQueue<std::vector<CubicBezierCurve>> curves(queue_capacity);
+	BoundedQueue<std::vector<StreamRecord>> records(queue_capacity);
+	bool valid = true;
+
+	// Chunk ends after its last whitespace, the number cut by the chunk boundary is carried to the next read
+	std::thread reader([&]{
+		std::vector<char> buffer(chunk_size);
+		size_t carry = 0;
+		REAL pending[8];
+		int num_pending = 0;
+		while (true){
+			size_t n = fread(buffer.data() + carry, 1, chunk_size - carry, input);
+			stats.bytes_read += n;
+			size_t size = carry + n;
+			bool last = n == 0 || feof(input);
+			if (size == 0) break;
+
+			size_t end = size;
+			if (!last){
+				while (end > 0 && !isspace((unsigned char)buffer[end - 1])) end--;
+				if (end == 0){
+					// A single number longer than a chunk
+					if (size == chunk_size){
+						valid = false;
+						break;
+					}
+					carry = size;
+					continue;
+				}
+			}
+			std::vector<char> rest(buffer.begin() + end, buffer.begin() + size);
+
+			std::vector<CubicBezierCurve> batch;
+			batch.reserve(end / 16);
+			bool parsed = parse_chunk(buffer.data(), buffer.data() + end, pending, num_pending, batch);
+			stats.chunks++;
+			if (!batch.empty()) curves.push(std::move(batch));
+			if (!parsed){
+				valid = false;
+				break;
+			}
+
+			memcpy(buffer.data(), rest.data(), rest.size());
+			carry = rest.size();
+			if (last) break;
+		}
+		if (num_pending != 0) valid = false;
+		curves.close();
+	});
+
+	std::thread converter([&]{
+		std::vector<CubicBezierCurve> batch;
+		while (curves.pop(batch)){
+			std::vector<StreamRecord> converted(batch.size());
+			for (int i = 0; i < batch.size(); i++){
+				convert_curve(batch[i], converted[i]);
+			}
+			records.push(std::move(converted));
+		}
+		records.close();
+	});
+
+	std::vector<StreamRecord> batch;
+	while (records.pop(batch)){
+		for (auto &record: batch){
+			write_record(output, record);
+		}
+		stats.curves += batch.size();
+	}
+
+	reader.join();
+	converter.join();
+	return valid;
+}
@@ -0,0 +1,38 @@
+#ifndef _STREAM_H_
+#define _STREAM_H_
+
+#include <stdio.h>
+#include "hierarchy.h"
+
+#define STREAM_CHUNK_SIZE      (1 << 20)   /* bytes read at once */
+#define STREAM_QUEUE_CAPACITY  4           /* batches waiting between two stages */
+
+// Biarc (or line) approximation of a curve with its error and the box of both arcs inflated by their errors
+class StreamRecord {
+public:
+	VectorArc arcs[2];
+	REAL errors[2];
+	AABB box;
+};
+
+class StreamStats {
+public:
+	long curves = 0;
+	long chunks = 0;
+	size_t bytes_read = 0;
+};
+
+// Converts the curve of each record, same as a leaf of the hierarchy
+void convert_curve(const CubicBezierCurve &curve, StreamRecord &record);
+
+// One line per record: for each arc its kind, center, radius, begin, end and major, then both errors and the box
+void write_record(FILE *output, const StreamRecord &record);
+
+// Input is text of control points "x y", 4 per curve, as saved by the viewer. Reader, converter and writer run
+// on their own threads, connected by queues of at most queue_capacity batches with the curves of one chunk each,
+// so memory use does not depend on the input size. Returns false on a malformed number or a truncated curve,
+// records converted before it are written
+bool process_stream(FILE *input, FILE *output, StreamStats &stats,
+	size_t chunk_size = STREAM_CHUNK_SIZE, int queue_capacity = STREAM_QUEUE_CAPACITY);
+
+#endif /* _STREAM_H_ */
@@ -0,0 +1,135 @@
+#include "text_import.h"
+#include <charconv>
+
+static inline bool is_separator(char c){
+	return c == ' ' || c == ',' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+static inline void skip_separators(const char *&p, const char *end){
+	while (p < end && is_separator(*p)) p++;
+}
+
+bool parse_real(const char *&p, const char *end, REAL &value){
+	skip_separators(p, end);
+	const char *q = p;
+	if (q < end && *q == '+') q++;
+	auto result = std::from_chars(q, end, value);
+	if (result.ec != std::errc()) return false;
+	p = result.ptr;
+	return true;
+}
+
+bool parse_points(const char *begin, const char *end, std::vector<CubicBezierCurve> &output){
+	const char *p = begin;
+	while (true){
+		skip_separators(p, end);
+		if (p == end) return true;
+		CubicBezierCurve curve;
+		for (int i = 0; i < 4; i++){
+			if (!parse_real(p, end, curve.control_pts[i][0]) || !parse_real(p, end, curve.control_pts[i][1])) return false;
+		}
+		output.push_back(curve);
+	}
+}
+
+static void add_line(const Point p1, const Point p2, std::vector<CubicBezierCurve> &output){
+	LineSegment line;
+	copy_point(p1, line.control_pts[0]);
+	copy_point(p2, line.control_pts[1]);
+	CubicBezierCurve curve;
+	elevate(&line, &curve);
+	output.push_back(curve);
+}
+
+// Reads n coordinate pairs, relative ones are offset by the current point
+static bool parse_coords(const char *&p, const char *end, int n, bool relative, const Point current, Point *points){
+	for (int i = 0; i < n; i++){
+		if (!parse_real(p, end, points[i][0]) || !parse_real(p, end, points[i][1])) return false;
+		if (relative){
+			points[i][0] += current[0];
+			points[i][1] += current[1];
+		}
+	}
+	return true;
+}
+
+bool parse_svg_path(const char *begin, const char *end, std::vector<CubicBezierCurve> &output, std::vector<int> *subpaths){
+	const char *p = begin;
+	char command = 0;
+	Point current = { 0.0, 0.0 }, start = { 0.0, 0.0 };
+	Point last_control;
+	bool after_cubic = false;
+	bool new_subpath = false;
+
+	while (true){
+		skip_separators(p, end);
+		if (p == end) return true;
+
+		if ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z')){
+			command = *p++;
+		}
+		// Numbers without a command, or after Z which takes none
+		else if (command == 0 || command == 'Z' || command == 'z') return false;
+
+		const bool relative = command >= 'a';
+		const int num_curves = output.size();
+		Point points[3];
+		switch (relative ? command - 'a' + 'A' : command){
+		case 'M':
+			if (!parse_coords(p, end, 1, relative, current, points)) return false;
+			copy_point(points[0], current);
+			copy_point(points[0], start);
+			new_subpath = true;
+			// Following pairs are implicit lines
+			command = relative ? 'l' : 'L';
+			break;
+		case 'L':
+			if (!parse_coords(p, end, 1, relative, current, points)) return false;
+			add_line(current, points[0], output);
+			copy_point(points[0], current);
+			break;
+		case 'H':
+		case 'V': {
+			REAL value;
+			if (!parse_real(p, end, value)) return false;
+			const int axis = (command == 'H' || command == 'h') ? 0 : 1;
+			copy_point(current, points[0]);
+			points[0][axis] = relative ? current[axis] + value : value;
+			add_line(current, points[0], output);
+			copy_point(points[0], current);
+			break;
+		}
+		case 'C':
+			if (!parse_coords(p, end, 3, relative, current, points)) return false;
+			break;
+		case 'S':
+			// First control point is the reflection of the last one if the previous command was a cubic
+			if (!parse_coords(p, end, 2, relative, current, points + 1)) return false;
+			if (after_cubic){
+				SET_PT2(points[0], 2.0 * current[0] - last_control[0], 2.0 * current[1] - last_control[1]);
+			}
+			else copy_point(current, points[0]);
+			break;
+		case 'Z':
+			if (current[0] != start[0] || current[1] != start[1]) add_line(current, start, output);
+			copy_point(start, current);
+			break;
+		default:
+			return false;
+		}
+
+		after_cubic = command == 'C' || command == 'c' || command == 'S' || command == 's';
+		if (after_cubic){
+			CubicBezierCurve curve;
+			copy_point(current, curve.control_pts[0]);
+			for (int i = 0; i < 3; i++) copy_point(points[i], curve.control_pts[i + 1]);
+			output.push_back(curve);
+			copy_point(points[1], last_control);
+			copy_point(points[2], current);
+		}
+		if (new_subpath && output.size() > num_curves){
+			if (subpaths) subpaths->push_back(num_curves);
+			new_subpath = false;
+		}
+	}
+}
@@ -0,0 +1,21 @@
+#ifndef _TEXT_IMPORT_H_
+#define _TEXT_IMPORT_H_
+
+#include <vector>
+#include "curve.h"
+
+// Parses a number at p with std::from_chars after skipping whitespace and commas, p is moved past it.
+// A leading '+' is accepted as in SVG. Returns false if there is no number at p
+bool parse_real(const char *&p, const char *end, REAL &value);
+
+// Whitespace separated control points "x y", 4 per curve. Returns false on a malformed number or a truncated
+// curve, curves before it are kept in output
+bool parse_points(const char *begin, const char *end, std::vector<CubicBezierCurve> &output);
+
+// SVG path data with commands M, L, H, V, C, S and Z, lowercase for relative coordinates. Lines are elevated to
+// cubics exactly, Z adds the closing line if the subpath is open. Index of the first curve of each subpath is
+// added to subpaths if given. Returns false on a malformed number or an unsupported command, curves before it are
+// kept in output
+bool parse_svg_path(const char *begin, const char *end, std::vector<CubicBezierCurve> &output, std::vector<int> *subpaths = nullptr);
+
+#endif /* _TEXT_IMPORT_H_ */
@@ -0,0 +1,119 @@
+#ifndef _TREE_SEARCH_H_
+#define _TREE_SEARCH_H_
+
+#include <queue>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include "hierarchy.h"
+
+// Minimum distance search shared by the box and circle hierarchies, utils.h must be included before this header.
+// Node has curve, left, right, and at leaves an arc with its approximation error. bound(node1, node2) is the lower
+// bound of a node pair, size(node) picks the node that is split and width(node) is the extent written to the trace.
+// Sampled points of each pair give the upper bound, arc distances of leaf pairs refine it
+template <typename Node, typename Bound, typename Size, typename Width>
+REAL tree_minimum_distance(std::shared_ptr<Node> tree1, std::shared_ptr<Node> tree2, int num_samples, MinDistanceResult &result,
+	SearchStats *stats, const SearchBudget *budget, Bound bound, Size size, Width width){
+	typedef std::pair<REAL, std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>>> min_node_pair;
+	std::priority_queue<min_node_pair, std::vector<min_node_pair>, std::greater<min_node_pair>> q;
+
+	if (stats) stats->reset();
+	auto begin = std::chrono::steady_clock::now();
+	long pops = 0;
+	result.budget_exhausted = false;
+
+	REAL lower_bound = bound(*tree1, *tree2);
+	REAL upper_bound = sample_points_distance(tree1->curve, tree2->curve, num_samples, result.point1, result.point2);
+	if (stats) stats->update_upper_bound();
+	result.curve1 = tree1->curve;
+	result.curve2 = tree2->curve;
+
+	// Smallest arc distance less the leaf errors over the leaf pairs already resolved
+	REAL leaf_lower_bound = std::numeric_limits<REAL>::max();
+
+	auto push = [&](std::shared_ptr<Node> node1, std::shared_ptr<Node> node2){
+		REAL child_bound = bound(*node1, *node2);
+		if (child_bound < upper_bound){
+			q.push(std::make_pair(child_bound, std::make_pair(node1, node2)));
+			if (stats) stats->push(q.size());
+		}
+		else if (stats) stats->pruned++;
+	};
+
+	q.push(std::make_pair(lower_bound, std::make_pair(tree1, tree2)));
+	if (stats) stats->push(q.size());
+	while (!q.empty()){
+		REAL curr_bound = q.top().first;
+		if (curr_bound > upper_bound){
+			// Remaining pairs are farther than the upper bound, only resolved leaf pairs can be closer
+			lower_bound = std::min(upper_bound, std::min(curr_bound, leaf_lower_bound));
+			break;
+		}
+		lower_bound = curr_bound;
+		if (budget && budget->exhausted(pops, begin)){
+			result.budget_exhausted = true;
+			lower_bound = std::min(upper_bound, std::min(lower_bound, leaf_lower_bound));
+			break;
+		}
+		auto node1 = q.top().second.first;
+		auto node2 = q.top().second.second;
+		q.pop();
+		pops++;
+		if (stats) stats->pop(lower_bound, upper_bound, q.size(), std::max(width(*node1), width(*node2)));
+
+		Point sample1, sample2;
+		REAL local_bound = sample_points_distance(node1->curve, node2->curve, num_samples, sample1, sample2);
+		if (upper_bound > local_bound) {
+			upper_bound = local_bound;
+			if (stats) stats->update_upper_bound();
+			result.curve1 = node1->curve;
+			result.curve2 = node2->curve;
+			copy_point(sample1, result.point1);
+			copy_point(sample2, result.point2);
+		}
+
+		if (node1->left == nullptr && node2->left == nullptr){
+			// Both BVH reached leaf node
+			// Set arc distance as upper bound, ignore biarc approximation error. It is kept even below the lower
+			// bound, so that the witnesses are always upper_bound apart, the lower bound is lowered to it on exit.
+			// Distance is taken between the witnesses, the returned one loses precision on arcs of huge radius
+			Point witness1, witness2;
+			if (stats) stats->leaf_tests++;
+			distance(*node1->arc, *node2->arc, witness1, witness2);
+			REAL local_distance = distance(witness1, witness2);
+			leaf_lower_bound = std::min(leaf_lower_bound, std::max((REAL)0.0, local_distance - node1->error - node2->error));
+			if (local_distance < upper_bound){
+				upper_bound = local_distance;
+				if (stats) stats->update_upper_bound();
+				result.curve1 = node1->curve;
+				result.curve2 = node2->curve;
+				copy_point(witness1, result.point1);
+				copy_point(witness2, result.point2);
+			}
+			continue;
+		}
+
+		if (upper_bound < lower_bound){
+			lower_bound = std::min(upper_bound, leaf_lower_bound);
+			break;
+		}
+
+		// Add child nodes to priority queue, larger node is divided
+		if (node1->left != nullptr && (size(*node1) > size(*node2) || node2->left == nullptr)){
+			push(node1->left, node2);
+			push(node1->right, node2);
+		}
+		else {
+			push(node1, node2->left);
+			push(node1, node2->right);
+		}
+	}
+	if (q.empty()) lower_bound = std::min(upper_bound, leaf_lower_bound);
+	if (stats) stats->final_gap = upper_bound - lower_bound;
+
+	result.lower_bound = lower_bound;
+	result.upper_bound = upper_bound;
+	return (upper_bound + lower_bound) / 2.0;
+}
+
+#endif /* _TREE_SEARCH_H_ */
@@ -2,46 +2,60 @@
 #include "utils.h"
 #include <algorithm>
 
-AABB get_arc_aabb(const Arc *arc){
-    REAL begin, end;
-    begin = arc->begin < 0 ? arc->begin + 2 * M_PI : arc->begin;
-    end = arc->begin < 0 ? arc->end + 2 * M_PI : arc->end;
-    
-    std::vector<REAL> cand_x;
-    std::vector<REAL> cand_y;
-
-    if (arc->radius != arc->radius){
-        cand_x.push_back(arc->center[0]);
-        cand_x.push_back(arc->begin);
-        cand_y.push_back(arc->center[1]);
-        cand_y.push_back(arc->end);
+static inline void arc_aabb_kernel(const Arc &arc, AABB &res){
+    // Line is stored as a start point in center, and an end point in begin and end, it needs no cos and sin
+    if (arc.radius != arc.radius){
+        res.x[0] = std::min(arc.center[0], arc.begin);
+        res.x[1] = std::max(arc.center[0], arc.begin);
+        res.y[0] = std::min(arc.center[1], arc.end);
+        res.y[1] = std::max(arc.center[1], arc.end);
+        return;
     }
-    else {
-        if (begin < 0.5 * M_PI && end > 0.5 * M_PI)
-            cand_y.push_back(arc->center[1] + arc->radius);
-        if (begin < 1.0 * M_PI && end > 1.0 * M_PI)
-            cand_x.push_back(arc->center[0] - arc->radius);
-        if (begin < 1.5 * M_PI && end > 1.5 * M_PI)
-            cand_y.push_back(arc->center[1] - arc->radius);
-        if (begin < 2.0 * M_PI && end > 2.0 * M_PI)
-            cand_x.push_back(arc->center[0] + arc->radius);
-
-        cand_x.push_back(arc->center[0] + arc->radius * cos(arc->begin));
-        cand_x.push_back(arc->center[0] + arc->radius * cos(arc->end));
-        cand_y.push_back(arc->center[1] + arc->radius * sin(arc->begin));
-        cand_y.push_back(arc->center[1] + arc->radius * sin(arc->end));
-    }
-
-    AABB res;
-    auto minmax_x = std::minmax_element(cand_x.begin(), cand_x.end());
-    auto minmax_y = std::minmax_element(cand_y.begin(), cand_y.end());
 
-    SET_VECTOR2(res.x, *(minmax_x.first), *(minmax_x.second));
-    SET_VECTOR2(res.y, *(minmax_y.first), *(minmax_y.second));
+    const REAL two_pi = 2.0 * M_PI;
+    const REAL half_pi = 0.5 * M_PI;
+
+    const REAL x_begin = arc.center[0] + arc.radius * cos(arc.begin);
+    const REAL y_begin = arc.center[1] + arc.radius * sin(arc.begin);
+    const REAL x_end = arc.center[0] + arc.radius * cos(arc.end);
+    const REAL y_end = arc.center[1] + arc.radius * sin(arc.end);
+
+    // Angle from begin to direction 0 wrapped into [0, 2pi), arc contains direction k * pi/2 if offset is within sweep
+    const REAL sweep = arc.end - arc.begin;
+    REAL offset = -arc.begin - two_pi * std::floor(-arc.begin / two_pi);
+    const REAL off0 = offset;
+    offset += half_pi;
+    const REAL off1 = offset >= two_pi ? offset - two_pi : offset;
+    offset += half_pi;
+    const REAL off2 = offset >= two_pi ? offset - two_pi : offset;
+    offset += half_pi;
+    const REAL off3 = offset >= two_pi ? offset - two_pi : offset;
+
+    REAL ax0 = std::min(x_begin, x_end), ax1 = std::max(x_begin, x_end);
+    REAL ay0 = std::min(y_begin, y_end), ay1 = std::max(y_begin, y_end);
+    ax1 = off0 < sweep ? arc.center[0] + arc.radius : ax1;
+    ay1 = off1 < sweep ? arc.center[1] + arc.radius : ay1;
+    ax0 = off2 < sweep ? arc.center[0] - arc.radius : ax0;
+    ay0 = off3 < sweep ? arc.center[1] - arc.radius : ay0;
+
+    res.x[0] = ax0;
+    res.x[1] = ax1;
+    res.y[0] = ay0;
+    res.y[1] = ay1;
+}
 
+AABB get_arc_aabb(const Arc *arc){
+    AABB res;
+    arc_aabb_kernel(*arc, res);
     return res;
 }
 
+void get_arc_aabb(const Arc *arcs, AABB *boxes, int num_arcs){
+    for (int i = 0; i < num_arcs; i++){
+        arc_aabb_kernel(arcs[i], boxes[i]);
+    }
+}
+
 CubicBezierCurve to_bezier(const Arc *arc){
     CubicBezierCurve bezier;
     Point *p;
@@ -17,6 +17,9 @@ public:
 
 AABB get_arc_aabb(const Arc *arc);
 
+// Computes boxes for an array of arcs in a single pass
+void get_arc_aabb(const Arc *arcs, AABB *boxes, int num_arcs);
+
 CubicBezierCurve to_bezier(const Arc *arc);
 
 REAL arc_approx_error_bound(const Arc *arc, const CubicBezierCurve *curve);
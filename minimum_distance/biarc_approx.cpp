@@ -237,7 +237,7 @@ void to_biarc(const CubicBezierCurve *curve, Point &inflect, Arc *arc1, Arc *arc
 	}
 }
 
-void draw_arc(const std::shared_ptr<Arc> arc){
+void draw_arc(const std::shared_ptr<Arc> &arc){
 	glColor3ub(255, 0, 0);
 	glLineWidth(10.0);
 	if (arc->is_line()){
@@ -295,7 +295,7 @@ REAL distance(const Point p, const Point line_begin, const Point line_end){
 	}
 }
 
-REAL distance(const std::shared_ptr<Arc> arc1, const std::shared_ptr<Arc> arc2)
+REAL distance(const std::shared_ptr<Arc> &arc1, const std::shared_ptr<Arc> &arc2)
 {
 	REAL d = std::numeric_limits<REAL>::max();
 	if (!arc1->is_line()){
@@ -17,6 +17,6 @@ void get_biarc_inflect(const CubicBezierCurve *curve, Point &inflect);
 
 void to_biarc(const CubicBezierCurve *curve, Point &inflect, Arc *arc1, Arc *arc2);
 
-REAL distance(const std::shared_ptr<Arc> arc1, const std::shared_ptr<Arc> arc2);
+REAL distance(const std::shared_ptr<Arc> &arc1, const std::shared_ptr<Arc> &arc2);
 
-void draw_arc(const std::shared_ptr<Arc> arc);
+void draw_arc(const std::shared_ptr<Arc> &arc);